@@ -7,13 +7,33 @@
 
 #include <taskbench/taskbench.h>
 
+#include <optional>
+#include <string>
+
+// usage: BlitzBench [input file] [--disk <directory>]
 int main(int argc, char** argv) {
   taskbench::cpu::Benchmark cpu_benchmark;
   taskbench::ram::Benchmark ram_benchmark;
   taskbench::gpu::Benchmark gpu_benchmark;
+  // the disk benchmark writes about 1.5 GiB to its directory: it only runs if a directory is given
+  std::optional<std::string> disk_directory;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "--disk" && i + 1 < argc) {
+      disk_directory = argv[++i];
+    } else {
+      // optional input file used instead of generated data by the compression, AES and string sort benchmarks
+      cpu_benchmark.set_input_file(arg);
+    }
+  }
   cpu_benchmark.run_all(taskbench::seconds(1));
   ram_benchmark.run_all(taskbench::seconds(1));
   gpu_benchmark.run_all(taskbench::seconds(1));
+  if (disk_directory) {
+    taskbench::disk::Benchmark disk_benchmark;
+    disk_benchmark.set_directory(*disk_directory);
+    disk_benchmark.run_all(taskbench::seconds(1));
+  }
 
   std::cout << "\nPress 'Enter' to exit ";
   std::cin.get();
@@ -7,15 +7,33 @@
 
 #pragma once
 
+#include <taskbench/utils/buffer.h>
+#include <taskbench/utils/concurrency.h>
 #include <taskbench/utils/timer.h>
+#include <taskbench/utils/topology.h>
+#include <taskbench/utils/worker_pool.h>
 
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <thread>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#define S_1_KiB 0x400
+#define S_2_KiB 0x800
+#define S_4_KiB 0x1000
+#define S_8_KiB 0x2000
+#define S_16_KiB 0x4000
+#define S_32_KiB 0x8000
+#define S_64_KiB 0x10000
+#define S_128_KiB 0x20000
+#define S_256_KiB 0x40000
+#define S_512_KiB 0x80000
 #define S_1_MiB 0x100000
 #define S_2_MiB 0x200000
 #define S_4_MiB 0x400000
@@ -35,6 +53,44 @@ namespace taskbench {
 
 typedef std::chrono::duration<double> seconds;
 
+/**
+ * @brief Work of a single worker of a multi threaded benchmark: job(thread_id, num_threads)
+ */
+typedef std::function<void(size_t, size_t)> ParallelJob;
+
+/**
+ * @brief Result of a multi threaded benchmark at a single thread count (see AbstractBenchmark::set_scaling)
+ */
+struct ScalingPoint {
+  size_t num_threads;
+  // mean runtime of a single operation
+  double runtime;
+  // bytes per second based on the mean runtime
+  double bps;
+  // operations per second based on the mean runtime
+  double ops;
+  // runtime of the smallest measured thread count divided by runtime
+  double speedup;
+  // speedup per thread relative to the smallest measured thread count
+  double efficiency;
+};
+
+/**
+ * @brief Result of a benchmark at a single point of a parameter sweep (e.g. one working set size)
+ */
+struct SweepPoint {
+  // value of the swept parameter, e.g. {"working_set": 4096}
+  nlohmann::json parameters;
+  uint64_t data_size;
+  uint64_t num_operations;
+  // mean runtime of a single operation
+  double runtime;
+  // bytes per second based on the mean runtime
+  double bps;
+  // operations per second based on the mean runtime
+  double ops;
+};
+
 class BenchmarkResult {
  public:
   BenchmarkResult(std::string name, uint64_t data_size, uint64_t num_operations);
@@ -57,22 +113,83 @@ class BenchmarkResult {
   [[nodiscard]] const std::vector<seconds>& runtimes() const;
   void add_runtime(seconds runtime);
 
+  /**
+   * @brief Number of operations that were executed within a single timed sample
+   */
+  [[nodiscard]] size_t batch_size() const;
+  void set_batch_size(size_t batch_size);
+
+  /**
+   * @brief Per worker start/finish times (relative to the barrier release) of each sample of a multi threaded
+   *  benchmark. The JSON result only holds the minimum, median and maximum of every worker over all samples.
+   */
+  [[nodiscard]] const std::vector<std::vector<utils::WorkerTiming>>& worker_timings() const;
+  void add_worker_timings(const std::vector<utils::WorkerTiming>& timings);
+
   nlohmann::json json();
   nlohmann::json summary_json();
 
+  /**
+   * @brief Results of a thread count sweep of a multi threaded benchmark ordered by the number of threads
+   */
+  [[nodiscard]] const std::vector<ScalingPoint>& scaling() const;
+  void add_scaling_point(size_t num_threads, seconds runtime);
+
+  /**
+   * @brief Results of a parameter sweep (e.g. over the working set size) in the order they were measured
+   */
+  [[nodiscard]] const std::vector<SweepPoint>& sweep() const;
+  void add_sweep_point(nlohmann::json parameters, uint64_t data_size, uint64_t num_operations, seconds runtime);
+
+  [[nodiscard]] size_t num_threads() const;
+  void set_num_threads(size_t num_threads);
+
+  /**
+   * @brief Parameters the benchmark was run with (e.g. thread placement), written to the "parameters" JSON object
+   */
+  [[nodiscard]] const nlohmann::json& parameters() const;
+  void set_parameter(const std::string& key, nlohmann::json value);
+
   [[nodiscard]] const std::string& name() const;
 
   [[nodiscard]] uint64_t data_size() const;
+  [[nodiscard]] uint64_t num_operations() const;
 
  private:
   std::string _name;
   std::vector<seconds> _runtimes;
   uint64_t _data_size;
   uint64_t _num_operations;
+  size_t _batch_size{1};
+  std::vector<std::vector<utils::WorkerTiming>> _worker_timings;
+  size_t _num_threads{1};
+  std::vector<ScalingPoint> _scaling;
+  std::vector<SweepPoint> _sweep;
+  nlohmann::json _parameters = nlohmann::json::object();
 };
 
 enum class VERBOSITY { OFF, MEDIUM, DETAILED, HIGH };
 
+/**
+ * @brief Parameters of the measurement loop shared by all benchmarks (see AbstractBenchmark::_measure).
+ *
+ * A measurement always stops once its time budget is exhausted. It stops earlier if max_samples samples were taken or
+ * if the relative standard error of the mean runtime dropped below target_rse.
+ */
+struct MeasurementConfig {
+  // untimed iterations executed before the first sample is recorded (also used to calibrate the batch size)
+  size_t warmup_iterations{1};
+  // short operations are batched until a single timed sample lasts at least this long
+  std::chrono::microseconds min_sample_time{1000};
+  // number of samples that are recorded regardless of the stopping rules
+  size_t min_samples{1};
+  // stop after this number of samples (0: no limit)
+  size_t max_samples{0};
+  // stop once the relative standard error of the mean drops below this value (0: disabled), evaluated only after at
+  // least max(min_samples, 5) samples
+  double target_rse{0.0};
+};
+
 /**
  * @brief Abstract Benchmark class implemented for each task set (cpu, gpu, ram, ...)
  */
@@ -90,6 +207,38 @@ class AbstractBenchmark {
 
   void set_verbosity(VERBOSITY verbosity);
 
+  void set_measurement_config(const MeasurementConfig& config);
+  [[nodiscard]] const MeasurementConfig& measurement_config() const;
+
+  /**
+   * @brief Number of threads used by multi threaded benchmarks. Defaults to utils::default_concurrency(), i.e. the cpus
+   *  the process may actually use within its affinity mask and cgroup (container) limits.
+   */
+  void set_num_threads(size_t num_threads);
+  [[nodiscard]] size_t num_threads() const;
+
+  /**
+   * @brief If enabled, multi threaded benchmarks are additionally measured with 1, 2, 4, ... threads up to their number
+   *  of threads. Each thread count gets the full time budget.
+   */
+  void set_scaling(bool enabled);
+
+  /**
+   * @brief Set how the workers of multi threaded benchmarks are pinned to cpus. Defaults to utils::Placement::NONE,
+   *  i.e. the workers are not pinned. Throws std::runtime_error if the placement is not possible on this machine. The
+   *  placement that was actually used ("none" if the topology is unknown) is written to the results.
+   * @param placement
+   * @param numa_node node used by utils::Placement::NUMA_NODE
+   */
+  void set_placement(utils::Placement placement, int numa_node = 0);
+
+  /**
+   * @brief Set the pages backing the benchmark buffers. The page mode that was actually used (see utils::RawBuffer) is
+   *  written to the "page_mode" parameter of the results.
+   */
+  void set_page_mode(utils::PageMode mode);
+  [[nodiscard]] utils::PageMode page_mode() const;
+
   /**
    * @brief Get the collected results as constant reference
    * @return
@@ -110,15 +259,147 @@ class AbstractBenchmark {
 
   void _register_benchmark(uint64_t data_size, uint64_t num_operations, const std::string& name);
 
+  /**
+   * @brief Lease a buffer of size elements backed by pages of the configured page mode from the global
+   *  utils::BufferPool. The memory may have been used by a previous benchmark.
+   * @param size
+   * @param fresh map new pages that are not touched yet (see utils::BufferPool::acquire)
+   */
+  template <typename T>
+  utils::Buffer<T> _allocate(size_t size, bool fresh = false) const {
+    return utils::Buffer<T>(size, _page_mode, utils::BufferPool::global(), fresh);
+  }
+
   void _add_result(const std::string& key, seconds val);
 
+  /**
+   * @brief Run the benchmarks of run (e.g. one run_* method). If one of their buffers does not fit into the memory
+   *  budget of the global utils::BufferPool, the remaining benchmarks of run are skipped instead of aborting run_all:
+   *  the skip is logged and recorded as result name with the reason as "skipped" parameter. Results of the benchmarks
+   *  that completed before the skip are kept.
+   * @param name
+   * @param run
+   */
+  void _run_within_budget(const std::string& name, const std::function<void()>& run);
+
+  /**
+   * @brief Measure op for the registered benchmark name using the configured MeasurementConfig.
+   *
+   * op is either timed as a whole or, if it returns seconds, reports the time of its timed region itself (e.g. to
+   * exclude per-operation setup). Recorded runtimes are always per operation, independent of the batch size.
+   * @param name name of a registered benchmark
+   * @param runtime time budget of the measurement
+   * @param op single benchmark operation
+   */
+  template <typename Op>
+  void _measure(const std::string& name, seconds runtime, Op&& op) {
+    if constexpr (std::is_same_v<std::invoke_result_t<Op>, seconds>) {
+      _run_measurement(name, runtime, [&op](size_t batch_size) {
+        seconds time(0);
+        for (size_t i = 0; i < batch_size; ++i) {
+          time += op();
+        }
+        return time;
+      });
+    } else {
+      _run_measurement(name, runtime, [&op](size_t batch_size) {
+        utils::Timer timer;
+        timer.start();
+        for (size_t i = 0; i < batch_size; ++i) {
+          op();
+        }
+        return timer.stop();
+      });
+    }
+  }
+
+  /**
+   * @brief Measurement loop behind _measure: warmup, batch calibration and stopping rules. The batch size is calibrated
+   *  before the first recorded sample and stays fixed afterwards.
+   * @param name name of a registered benchmark
+   * @param runtime time budget of the measurement
+   * @param sample executes the given number of operations and returns the time they took
+   * @param on_sample called after each recorded sample (not after warmup and discarded calibration runs)
+   */
+  void _run_measurement(const std::string& name, seconds runtime, const std::function<seconds(size_t)>& sample,
+                        const std::function<void()>& on_sample = {});
+  void _run_measurement(BenchmarkResult& bm_res, seconds runtime, const std::function<seconds(size_t)>& sample,
+                        const std::function<void()>& on_sample = {});
+
+  /**
+   * @brief Measure job(thread_id, num_threads) executed by num_threads workers of the persistent worker pool.
+   *
+   * Only the time from the barrier release until the last worker finished is measured. The start and finish time of
+   * every worker is recorded for each sample. If scaling is enabled, the job is additionally measured with 1, 2, 4, ...
+   * threads and the results are added as scaling points.
+   * @param name name of a registered benchmark
+   * @param runtime time budget of the measurement (per thread count)
+   * @param num_threads number of workers executing job
+   * @param job work of a single worker
+   * @param prepare untimed setup prepare(num_threads) executed before each run of the workers
+   */
+  void _measure_parallel(const std::string& name, seconds runtime, size_t num_threads, const ParallelJob& job,
+                         const std::function<void(size_t)>& prepare = {});
+
+  /**
+   * @brief Measure job(thread_id, num_threads) once for every value in sizes and add the results as sweep points of the
+   *  registered benchmark name. The time budget is split evenly among the sizes.
+   * @param name name of a registered benchmark
+   * @param runtime time budget of the whole sweep
+   * @param num_threads number of workers executing job
+   * @param parameter name of the swept parameter in the sweep points (e.g. "working_set")
+   * @param sizes values of the swept parameter
+   * @param resize untimed resize(size) executed before the measurement of each size, returns the number of bytes
+   *  processed by a single run of the workers. The number of operations of a sweep point is scaled by the same factor
+   *  relative to the registered benchmark (i.e. a constant number of bytes per operation is assumed).
+   * @param job work of a single worker
+   * @param prepare untimed setup prepare(num_threads) executed before each run of the workers
+   * @param annotate annotate(size) is called after the measurement of size and returns additional values that are
+   *  stored in the parameters of its sweep point (e.g. a bandwidth achieved at the same time)
+   * @param operations operations(size) returns the number of operations of a single run of the workers for size,
+   *  replacing the scaling by bytes (e.g. for work that grows faster than the data)
+   * @param on_sample on_sample(runs) is called after each recorded sample with the number of runs of the workers it
+   *  consists of, i.e. the last runs. Warmup and calibration runs before the first recorded sample are not followed by
+   *  a call.
+   */
+  void _measure_parallel_sweep(const std::string& name, seconds runtime, size_t num_threads,
+                               const std::string& parameter, const std::vector<uint64_t>& sizes,
+                               const std::function<uint64_t(uint64_t)>& resize, const ParallelJob& job,
+                               const std::function<void(size_t)>& prepare = {},
+                               const std::function<nlohmann::json(uint64_t)>& annotate = {},
+                               const std::function<uint64_t(uint64_t)>& operations = {},
+                               const std::function<void(size_t)>& on_sample = {});
+
+  /**
+   * @brief Get the worker pool with num_threads workers pinned according to the current placement. The pool is reused
+   *  as long as the number of threads and the placement do not change.
+   */
+  utils::WorkerPool& _worker_pool(size_t num_threads);
+
   void _print_runtime(const BenchmarkResult& bm_res);
   void _print_gib_per_second(const BenchmarkResult& bm_res);
   void _print_o_per_second(const BenchmarkResult& bm_res);
+  void _print_latency(const BenchmarkResult& bm_res);
 
   std::map<std::string, BenchmarkResult> _benchmark_result;
 
   VERBOSITY _verbosity = VERBOSITY::DETAILED;
+  MeasurementConfig _measurement_config;
+  size_t _num_threads{utils::default_concurrency()};
+  bool _scaling{false};
+  utils::Placement _placement{utils::Placement::NONE};
+  int _numa_node{0};
+  utils::PageMode _page_mode{utils::PageMode::DEFAULT};
+
+ private:
+  void _measure_on_pool(BenchmarkResult& bm_res, seconds runtime, size_t num_threads, const ParallelJob& job,
+                        const std::function<void(size_t)>& prepare,
+                        const std::function<void(size_t)>& on_sample = {});
+
+  std::unique_ptr<utils::WorkerPool> _pool;
+
+  [[nodiscard]] size_t _calibrate_batch_size(size_t batch_size, seconds sample_time) const;
+  [[nodiscard]] bool _stop_measurement(const BenchmarkResult& bm_res, seconds elapsed, seconds runtime) const;
 };
 
 }  // namespace taskbench
\ No newline at end of file
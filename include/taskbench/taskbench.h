@@ -8,5 +8,6 @@
 #pragma once
 
 #include <taskbench/tasks/cpu/benchmark.h>
+#include <taskbench/tasks/disk/benchmark.h>
 #include <taskbench/tasks/gpu/benchmark.h>
 #include <taskbench/tasks/ram/benchmark.h>
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace taskbench::cpu::aes {
@@ -27,4 +29,25 @@ std::vector<unsigned char> encrypt(const std::vector<unsigned char>& data, const
  */
 std::vector<unsigned char> decrypt(const std::vector<unsigned char>& data, const std::vector<unsigned char>& key);
 
+// data size of encrypt/decrypt must be a multiple of block_size
+inline constexpr size_t block_size = 16;
+
+/**
+ * @brief Encrypt size bytes of data using AES encryption without copying the input
+ * @param data
+ * @param size multiple of block_size
+ * @param key
+ * @return encrypted data of size bytes
+ */
+std::unique_ptr<unsigned char[]> encrypt(const unsigned char* data, size_t size, const std::vector<unsigned char>& key);
+
+/**
+ * @brief Decrypt size bytes of data using AES decryption without copying the input
+ * @param data
+ * @param size multiple of block_size
+ * @param key
+ * @return decrypted data of size bytes
+ */
+std::unique_ptr<unsigned char[]> decrypt(const unsigned char* data, size_t size, const std::vector<unsigned char>& key);
+
 }  // namespace taskbench::cpu::aes
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace taskbench::cpu::aes {
+
+/**
+ * @brief Implementations of the AES Engine
+ */
+enum class Implementation {
+  // byte oriented AES and bitwise GHASH (any cpu)
+  PORTABLE,
+  // AES-NI and PCLMULQDQ on 128 bit registers, 8 blocks in flight
+  AESNI,
+  // VAES and VPCLMULQDQ on 256 bit registers, 16 blocks in flight
+  VAES
+};
+
+std::string to_string(Implementation implementation);
+
+/**
+ * @brief Check via CPUID if the cpu (and operating system) supports the instructions of implementation
+ */
+bool is_supported(Implementation implementation);
+
+/**
+ * @brief Supported implementations, the fastest one last
+ */
+std::vector<Implementation> implementations();
+
+enum class Mode {
+  // counter mode: the data is xored with the encrypted counter blocks (encryption and decryption are the same)
+  CTR,
+  // Galois/Counter mode: CTR encryption and a GHASH authentication tag
+  GCM
+};
+
+std::string to_string(Mode mode);
+
+inline constexpr size_t key_size = 32;
+inline constexpr size_t nonce_size = 12;
+inline constexpr size_t tag_size = 16;
+
+/**
+ * @brief AES-256 in CTR and GCM mode. The key schedule (and the GHASH key powers) are computed once by the constructor,
+ *  all operations work on caller provided buffers and do not allocate. Input and output may be the same buffer. Counter
+ *  blocks consist of the 12 byte nonce followed by a 32 bit big endian block counter (as in GCM).
+ */
+class Engine {
+ public:
+  /**
+   * @param key key_size bytes
+   * @param implementation throws std::runtime_error if it is not supported
+   */
+  Engine(const unsigned char* key, Implementation implementation);
+
+  /**
+   * @brief Engine using the fastest supported implementation
+   */
+  explicit Engine(const unsigned char* key);
+
+  [[nodiscard]] Implementation implementation() const;
+
+  /**
+   * @brief Encrypt or decrypt size bytes in CTR mode
+   * @param nonce nonce_size bytes
+   * @param counter counter of the first block
+   */
+  void ctr(const unsigned char* nonce, uint32_t counter, const unsigned char* input, unsigned char* output,
+           size_t size) const;
+
+  /**
+   * @brief Encrypt size bytes in GCM mode and authenticate them with aad
+   * @param tag output of tag_size bytes
+   */
+  void gcm_encrypt(const unsigned char* nonce, const unsigned char* aad, size_t aad_size, const unsigned char* input,
+                   unsigned char* output, size_t size, unsigned char* tag) const;
+
+  /**
+   * @brief Decrypt size bytes in GCM mode
+   * @return true if tag matches the data and aad (output is written in any case)
+   */
+  [[nodiscard]] bool gcm_decrypt(const unsigned char* nonce, const unsigned char* aad, size_t aad_size,
+                                 const unsigned char* input, unsigned char* output, size_t size,
+                                 const unsigned char* tag) const;
+
+  // number of GHASH key powers (blocks hashed per reduction)
+  static constexpr size_t num_hash_powers = 16;
+
+ private:
+  void _gcm(const unsigned char* nonce, const unsigned char* aad, size_t aad_size, const unsigned char* input,
+            unsigned char* output, size_t size, bool encrypt, unsigned char* tag) const;
+
+  Implementation _implementation;
+  // 15 round keys of AES-256
+  alignas(32) std::array<unsigned char, 15 * 16> _round_keys{};
+  // GHASH key H = E(0) in GCM byte order
+  std::array<unsigned char, 16> _hash_key{};
+  // H^16, H^15, ..., H^1 byte reflected (carry-less multiplication implementations)
+  alignas(32) std::array<unsigned char, num_hash_powers * 16> _hash_powers{};
+};
+
+}  // namespace taskbench::cpu::aes
\ No newline at end of file
@@ -9,14 +9,21 @@
 
 #include <taskbench/benchmark.h>
 #include <taskbench/tasks/cpu/aes.h>
+#include <taskbench/tasks/cpu/aes_engine.h>
 #include <taskbench/tasks/cpu/compression.h>
 #include <taskbench/tasks/cpu/fft.h>
 #include <taskbench/tasks/cpu/mmul.h>
 #include <taskbench/tasks/cpu/sort.h>
+#include <taskbench/tasks/cpu/string_sort.h>
 #include <taskbench/tasks/cpu/synthetic.h>
+#include <taskbench/utils/data_generator.h>
 
+#include <barrier>
+#include <functional>
 #include <map>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace taskbench::cpu {
 
@@ -34,9 +41,117 @@ class Benchmark : public AbstractBenchmark {
   void run_sort(seconds runtime);
   void run_synthetic(seconds runtime);
 
+  /**
+   * @brief Set the input distributions of the integer and floating point sort benchmarks
+   */
+  void set_distributions(std::vector<utils::Distribution> distributions);
+
+  /**
+   * @brief Set the payload sizes (bytes) of the record sort benchmarks, each one of sort::record_payloads
+   */
+  void set_record_payloads(std::vector<size_t> payloads);
+
+  /**
+   * @brief Use the file at path as input of the compression and AES benchmarks and its newline delimited lines as keys
+   *  of the string sort benchmark instead of generated data. The file is memory mapped and not copied, throughput is
+   *  based on its size.
+   */
+  void set_input_file(std::string path);
+
  private:
+  /**
+   * @brief Run the single and multi threaded (de)compression benchmarks on input. Multi threaded compression is
+   *  measured with independent frames per thread (chunked) and with ZStandard's own workers on a single frame, followed
+   *  by the level sweep on the first compression_sweep_size bytes of input.
+   * @param output decompression target of input.size() bytes (may be input)
+   * @param parameters written to the parameters of the results
+   * @param suffix appended to the benchmark names
+   */
+  void _run_compression(seconds runtime, std::span<const char> input, std::span<char> output,
+                        const nlohmann::json& parameters, const std::string& suffix);
+
+  /**
+   * @brief Run the single threaded compression benchmark on input for each of compression::levels
+   * @param suffix appended to the benchmark names ("Compression (ZStandard, level <level><suffix>)")
+   */
+  void _run_compression_levels(seconds runtime, std::span<const char> input, const nlohmann::json& parameters,
+                               const std::string& suffix);
+
+  void _run_aes_file(seconds runtime, const std::vector<unsigned char>& key);
+
+  /**
+   * @brief Run CTR encryption and GCM en- and decryption of size bytes of data with every supported AES engine
+   *  implementation
+   * @param key at least aes::key_size bytes
+   * @param parameters written to the parameters of the results
+   * @param suffix appended to the benchmark names ("AES <mode> <operation> (<implementation><suffix>)")
+   */
+  void _run_aes_engines(seconds runtime, const unsigned char* data, size_t size, const std::vector<unsigned char>& key,
+                        const nlohmann::json& parameters, const std::string& suffix);
+
+  /**
+   * @brief Run CTR encryption of size bytes of data split into one independently counted segment per thread with the
+   *  fastest AES engine implementation. Always measured with 1, 2, 4, ... threads up to the number of threads, the
+   *  reference cycles per byte (summed over all threads) are reported if there is an invariant time stamp counter.
+   * @param parameters written to the parameters of the result
+   * @param suffix appended to the benchmark name ("AES CTR Encryption (multi threaded<suffix>)")
+   */
+  void _run_aes_parallel(seconds runtime, const unsigned char* data, size_t size, const std::vector<unsigned char>& key,
+                         const nlohmann::json& parameters, const std::string& suffix);
+
+  /**
+   * @brief Run std::sort, parallel std::sort, sample sort and radix sort on inputs of T following distribution
+   * @param type_name used in the benchmark names ("Sorting <type_name> (<engine>, <distribution>)")
+   */
+  template <typename T>
+  void _run_sort_engines(seconds runtime, const std::string& type_name, utils::Distribution distribution);
+
+  /**
+   * @brief Run std::sort, multikey quicksort and MSD radix sort on handles of strings stored contiguously in chars
+   * @param suffix appended to the benchmark names ("Sorting Strings (arena, <engine><suffix>)")
+   */
+  void _run_string_sort_engines(seconds runtime, const char* chars, size_t num_chars,
+                                const std::vector<string_sort::Handle>& handles, const std::string& suffix);
+
+  /**
+   * @brief Sort records of a key and Payload bytes of payload as array of structs, as struct of arrays and by key and
+   *  index with a gather of the records
+   */
+  template <size_t Payload>
+  void _run_record_sort(seconds runtime);
+
+  /**
+   * @brief Measure batches of fft_batch_points points (at least one transform) on all threads: whole transforms are
+   *  distributed among the threads or, if a batch has fewer transforms than threads, every transform is executed by all
+   *  threads. The result is measured for transforms of points points, the sweep covers 2^8 to 2^24 points. Reported as
+   *  floating point operations per second.
+   * @param point_size input bytes of a point (data size of the results)
+   * @param resize resize(points) prepares transforms of points points and returns their floating point operations
+   * @param transform transform(index, thread_id, num_threads, barrier) executes transform index of the batch (the
+   *  whole transform if barrier is nullptr)
+   * @param restore restore(points) resets the input of the first points points before every run (untimed), empty if
+   *  transform does not modify its input
+   * @param parameters added to the parameters of the result
+   */
+  void _run_fft_batches(seconds runtime, const std::string& name, uint64_t points, size_t point_size,
+                        const std::function<double(uint64_t)>& resize,
+                        const std::function<void(size_t, size_t, size_t, std::barrier<>*)>& transform,
+                        const std::function<void(size_t)>& restore, const nlohmann::json& parameters);
+
+  // input bytes of the compression level sweep (the strong levels compress only a few MiB/s)
+  static constexpr size_t compression_sweep_size = S_4_MiB;
+  // points transformed per run of the multi threaded FFT benchmarks
+  static constexpr uint64_t fft_batch_points = S_4_MiB;
+  // largest transform of the FFT sweeps
+  static constexpr uint64_t fft_max_points = S_16_MiB;
+
   uint64_t _num_ops{4000000000};
   uint64_t _num_ops_div{400000000};
+  std::vector<utils::Distribution> _distributions{
+      utils::Distribution::UNIFORM,        utils::Distribution::ZIPF,          utils::Distribution::SORTED,
+      utils::Distribution::REVERSE_SORTED, utils::Distribution::NEARLY_SORTED, utils::Distribution::FEW_UNIQUE};
+  std::vector<size_t> _record_payloads{16, 64, 128};
+  std::string _input_file;
 };
 
 }  // namespace taskbench::cpu
\ No newline at end of file
@@ -7,10 +7,22 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <vector>
 
+// opaque ZStandard contexts (see zstd.h)
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
 namespace taskbench::cpu::compression {
 
+// level of compress() and of Engines without explicit level
+inline constexpr int default_level = 9;
+
+// levels of the level sweep: fast (negative) levels up to the strongest level without --ultra
+inline constexpr std::array<int, 10> levels{-7, -3, -1, 1, 3, 6, 9, 12, 15, 19};
+
 /**
  * @brief Compress src using ZStandard
  * @param src
@@ -25,4 +37,87 @@ void compress(const std::vector<char>& src, std::vector<char>& dst);
  */
 void decompress(const std::vector<char>& src, std::vector<char>& dst);
 
+/**
+ * @brief Compress src_size bytes of src into dst using ZStandard
+ * @param src
+ * @param src_size
+ * @param dst
+ * @param dst_capacity
+ * @return compressed size
+ */
+size_t compress(const char* src, size_t src_size, char* dst, size_t dst_capacity);
+
+/**
+ * @brief Decompress a ZStandard frame of src_size bytes into dst
+ * @param src
+ * @param src_size
+ * @param dst
+ * @param dst_capacity
+ * @return decompressed size
+ */
+size_t decompress(const char* src, size_t src_size, char* dst, size_t dst_capacity);
+
+/**
+ * @brief Maximal compressed size of src_size bytes (worst case)
+ * @param src_size
+ * @return
+ */
+size_t compress_bound(size_t src_size);
+
+/**
+ * @brief Check if the linked ZStandard library was built with multi threading support (ZSTD_c_nbWorkers > 0)
+ */
+bool supports_workers();
+
+/**
+ * @brief ZStandard compression and decompression contexts that are reused across calls: unlike the one-shot functions,
+ *  the (de)compression state is allocated once and not per frame. An Engine must only be used by one thread at a time.
+ */
+class Engine {
+ public:
+  /**
+   * @param level compression level (see set_level)
+   * @param num_workers see set_num_workers
+   */
+  explicit Engine(int level = default_level, int num_workers = 0);
+  ~Engine();
+
+  Engine(const Engine&) = delete;
+  Engine& operator=(const Engine&) = delete;
+  Engine(Engine&& other) noexcept;
+  Engine& operator=(Engine&& other) noexcept;
+
+  /**
+   * @brief Set the compression level (ZSTD_minCLevel() to ZSTD_maxCLevel(), negative levels are faster). Levels out of
+   *  range are clamped by ZStandard.
+   */
+  void set_level(int level);
+  [[nodiscard]] int level() const;
+
+  /**
+   * @brief Number of worker threads ZStandard spawns to compress a frame (ZSTD_c_nbWorkers), 0 compresses on the
+   *  calling thread. Throws std::runtime_error if num_workers > 0 is not supported (see supports_workers).
+   */
+  void set_num_workers(int num_workers);
+  [[nodiscard]] int num_workers() const;
+
+  /**
+   * @brief Compress src_size bytes of src into a single frame in dst
+   * @return compressed size, throws std::runtime_error if dst_capacity is too small
+   */
+  size_t compress(const char* src, size_t src_size, char* dst, size_t dst_capacity);
+
+  /**
+   * @brief Decompress a frame of src_size bytes into dst
+   * @return decompressed size, throws std::runtime_error on corrupted input or if dst_capacity is too small
+   */
+  size_t decompress(const char* src, size_t src_size, char* dst, size_t dst_capacity);
+
+ private:
+  ZSTD_CCtx_s* _cctx{nullptr};
+  ZSTD_DCtx_s* _dctx{nullptr};
+  int _level{default_level};
+  int _num_workers{0};
+};
+
 }  // namespace taskbench::cpu::compression
\ No newline at end of file
@@ -7,8 +7,12 @@
 
 #pragma once
 
+#include <barrier>
 #include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <valarray>
+#include <vector>
 
 #define M_PI 3.14159265358979323846
 
@@ -28,4 +32,119 @@ void fft(std::valarray<std::complex<double>>& data);
  */
 void ifft(std::valarray<std::complex<double>>& data);
 
+/**
+ * @brief In place, iterative radix-2 FFT of a fixed power of two size. The twiddle factors and the bit reversal
+ *  permutation are computed once by the constructor, executing a plan does not allocate. Stages whose butterflies stay
+ *  within a cache sized block are executed block by block. The butterflies use AVX2 if available.
+ *
+ * A transform is either executed by a single thread or by num_threads threads that all call the overload taking
+ *  thread_id with the same data and a barrier of num_threads participants.
+ */
+class Plan {
+ public:
+  /**
+   * @param size number of points, throws std::runtime_error if it is not a power of two
+   */
+  explicit Plan(size_t size);
+
+  /**
+   * @brief Forward transform of size points
+   */
+  void forward(std::complex<double>* data) const;
+  void forward(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>& barrier) const;
+
+  /**
+   * @brief Inverse transform of size points (scaled by 1 / size)
+   */
+  void inverse(std::complex<double>* data) const;
+  void inverse(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>& barrier) const;
+
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief Floating point operations of a transform by the usual convention of 5 * size * log2(size)
+   */
+  [[nodiscard]] double flops() const;
+
+ private:
+  void _execute(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>* barrier) const;
+  /**
+   * @brief Turn the forward transform into the inverse for the pairs (k, size - k), k in [begin, end) and
+   *  k <= size / 2: swap and scale by 1 / size
+   */
+  void _reverse(std::complex<double>* data, size_t begin, size_t end) const;
+
+  size_t _size;
+  // pairs (i, j) with i < j and j = bit reversal of i
+  std::vector<std::pair<uint32_t, uint32_t>> _swaps;
+  // twiddles of the stage combining transforms of length h at [h, 2h): exp(-2 pi i k / 2h)
+  std::vector<std::complex<double>> _twiddles;
+};
+
+/**
+ * @brief FFT of size real values (power of two, at least 4) computed by a complex transform of size / 2 points. The
+ *  output holds the size / 2 + 1 non redundant coefficients. Threads are used like by Plan.
+ */
+class RealPlan {
+ public:
+  explicit RealPlan(size_t size);
+
+  /**
+   * @param input size values
+   * @param output size / 2 + 1 coefficients (must not overlap input)
+   */
+  void forward(const double* input, std::complex<double>* output) const;
+  void forward(const double* input, std::complex<double>* output, size_t thread_id, size_t num_threads,
+               std::barrier<>& barrier) const;
+
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief Floating point operations of a transform by the usual convention of 2.5 * size * log2(size)
+   */
+  [[nodiscard]] double flops() const;
+
+ private:
+  void _pack(const double* input, std::complex<double>* output, size_t begin, size_t end) const;
+  void _split(std::complex<double>* output, size_t begin, size_t end) const;
+
+  size_t _size;
+  Plan _plan;
+  // exp(-2 pi i k / size) for k in [0, size / 2]
+  std::vector<std::complex<double>> _twiddles;
+};
+
+/**
+ * @brief 2D FFT of rows x cols points (row major, both powers of two): the rows are transformed, the matrix is
+ *  transposed into a buffer (in cache sized tiles), the rows of the buffer (columns of the data) are transformed and
+ *  the buffer is transposed back. Threads are used like by Plan.
+ */
+class Plan2D {
+ public:
+  Plan2D(size_t rows, size_t cols);
+
+  /**
+   * @param data rows * cols points
+   * @param buffer scratch memory of rows * cols points
+   */
+  void forward(std::complex<double>* data, std::complex<double>* buffer) const;
+  void forward(std::complex<double>* data, std::complex<double>* buffer, size_t thread_id, size_t num_threads,
+               std::barrier<>& barrier) const;
+
+  [[nodiscard]] size_t rows() const;
+  [[nodiscard]] size_t cols() const;
+
+  /**
+   * @brief Floating point operations of a transform by the usual convention of 5 * N * log2(N), N = rows * cols
+   */
+  [[nodiscard]] double flops() const;
+
+ private:
+  void _execute(std::complex<double>* data, std::complex<double>* buffer, size_t thread_id, size_t num_threads,
+                std::barrier<>* barrier) const;
+
+  Plan _row_plan;
+  Plan _column_plan;
+};
+
 }  // namespace taskbench::cpu::fft
\ No newline at end of file
@@ -8,10 +8,27 @@
 #pragma once
 
 #include <taskbench/utils/concepts.h>
+#include <taskbench/utils/worker_pool.h>
 
 #include <algorithm>
+#include <array>
+#include <barrier>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// execution policies require a parallel backend (TBB) with libstdc++ and libc++, see src/tasks/CMakeLists.txt
+#if defined(TASKBENCH_PARALLEL_STL) || defined(_MSC_VER)
+#include <execution>
+#define TASKBENCH_EXECUTION_POLICIES 1
+#endif
+
 namespace taskbench::cpu::sort {
 
 template <typename T>
@@ -20,4 +37,340 @@ void sort(std::vector<T>& data) {
   std::sort(data.begin(), data.end());
 }
 
+template <typename T>
+  requires utils::IsSortable<T>
+void sort(T* data, size_t size) {
+  std::sort(data, data + size);
+}
+
+/**
+ * @brief True if parallel_std_sort runs in parallel
+ */
+#if defined(TASKBENCH_EXECUTION_POLICIES)
+inline constexpr bool has_execution_policies = true;
+#else
+inline constexpr bool has_execution_policies = false;
+#endif
+
+/**
+ * @brief std::sort using the parallel unsequenced execution policy (sequential if execution policies are not
+ *  available). The number of threads is chosen by the standard library.
+ */
+template <typename T>
+  requires utils::IsSortable<T>
+void parallel_std_sort(T* data, size_t size) {
+#if defined(TASKBENCH_EXECUTION_POLICIES)
+  std::sort(std::execution::par_unseq, data, data + size);
+#else
+  std::sort(data, data + size);
+#endif
+}
+
+/**
+ * @brief Parallel sorting by regular sampling. Every one of num_threads threads must call operator()(thread_id):
+ *  1. each thread sorts its partition and takes num_threads regular samples of it
+ *  2. the sorted samples determine num_threads - 1 pivots that split every partition into num_threads runs
+ *  3. the runs are scattered to buffer so that the runs of bucket j are adjacent
+ *  4. thread j merges the runs of bucket j back into data
+ *
+ * Elements are ordered by value and, among equal values, by their position after step 1. Samples and pivots carry that
+ * position, so that the copies of a frequent value are split across buckets instead of all landing in one bucket.
+ */
+template <typename T>
+  requires utils::IsSortable<T>
+class SampleSort {
+ public:
+  /**
+   * @param data
+   * @param size
+   * @param buffer scratch memory of size elements
+   * @param num_threads
+   */
+  SampleSort(T* data, size_t size, T* buffer, size_t num_threads)
+      : _data(data),
+        _size(size),
+        _buffer(buffer),
+        _num_threads(num_threads),
+        _barrier(static_cast<std::ptrdiff_t>(num_threads)),
+        _samples(num_threads * num_threads),
+        _pivots(num_threads - 1),
+        _counts(num_threads * num_threads) {}
+
+  void operator()(size_t thread_id) {
+    size_t p = _num_threads;
+    // too small to be split into num_threads runs per partition
+    if (_size < p * p * min_run_size) {
+      if (thread_id == 0) {
+        std::sort(_data, _data + _size);
+      }
+      return;
+    }
+
+    auto [begin, end] = utils::partition(_size, thread_id, p);
+    std::sort(_data + begin, _data + end);
+    for (size_t i = 0; i < p; ++i) {
+      size_t position = begin + i * (end - begin) / p;
+      _samples[thread_id * p + i] = {_data[position], position};
+    }
+    _barrier.arrive_and_wait();
+
+    if (thread_id == 0) {
+      std::sort(_samples.begin(), _samples.end());
+      for (size_t j = 1; j < p; ++j) {
+        _pivots[j - 1] = _samples[j * p + p / 2 - 1];
+      }
+    }
+    _barrier.arrive_and_wait();
+
+    // run j of this partition holds the elements in (pivot j - 1, pivot j]: of the elements equal to a pivot value,
+    // those up to the pivot position belong to the lower run
+    size_t* counts = &_counts[thread_id * p];
+    T* run = _data + begin;
+    for (size_t j = 0; j + 1 < p; ++j) {
+      const auto& [value, position] = _pivots[j];
+      auto [lower, upper] = std::equal_range(run, _data + end, value);
+      T* split = std::clamp(_data + position + 1, lower, upper);
+      counts[j] = static_cast<size_t>(split - run);
+      run = split;
+    }
+    counts[p - 1] = static_cast<size_t>(_data + end - run);
+    _barrier.arrive_and_wait();
+
+    run = _data + begin;
+    for (size_t j = 0; j < p; ++j) {
+      std::copy_n(run, counts[j], _buffer + _run_offset(thread_id, j));
+      run += counts[j];
+    }
+    _barrier.arrive_and_wait();
+
+    _merge_bucket(thread_id);
+  }
+
+  // partitions smaller than num_threads * min_run_size elements are sorted by a single thread
+  static constexpr size_t min_run_size = 16;
+
+ private:
+  /**
+   * @brief Offset of run j of partition thread_id in buffer
+   */
+  size_t _run_offset(size_t thread_id, size_t j) const {
+    size_t offset = 0;
+    for (size_t t = 0; t < _num_threads; ++t) {
+      for (size_t k = 0; k < j; ++k) {
+        offset += _counts[t * _num_threads + k];
+      }
+      if (t < thread_id) {
+        offset += _counts[t * _num_threads + j];
+      }
+    }
+    return offset;
+  }
+
+  /**
+   * @brief k-way merge of the runs of bucket j in buffer into data
+   */
+  void _merge_bucket(size_t j) {
+    struct Run {
+      const T* pos;
+      const T* end;
+    };
+    std::vector<Run> runs;
+    for (size_t t = 0; t < _num_threads; ++t) {
+      const T* first = _buffer + _run_offset(t, j);
+      size_t count = _counts[t * _num_threads + j];
+      if (count > 0) {
+        runs.push_back({first, first + count});
+      }
+    }
+    T* out = _data + _run_offset(0, j);
+    auto greater = [](const Run& a, const Run& b) { return *b.pos < *a.pos; };
+    std::priority_queue<Run, std::vector<Run>, decltype(greater)> heap(greater, std::move(runs));
+    while (!heap.empty()) {
+      Run run = heap.top();
+      heap.pop();
+      *out++ = *run.pos++;
+      if (run.pos != run.end) {
+        heap.push(run);
+      }
+    }
+  }
+
+  T* _data;
+  size_t _size;
+  T* _buffer;
+  size_t _num_threads;
+  std::barrier<> _barrier;
+  // (value, position) pairs, ordered by value and position
+  std::vector<std::pair<T, size_t>> _samples;
+  std::vector<std::pair<T, size_t>> _pivots;
+  // _counts[t * num_threads + j]: size of run j of partition t
+  std::vector<size_t> _counts;
+};
+
+template <typename T>
+concept IsRadixSortable = (std::is_integral_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) ||
+                          std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * @brief Unsigned key of value with the same order as value (NaNs excluded)
+ */
+template <typename T>
+  requires IsRadixSortable<T>
+auto radix_key(T value) {
+  using Key = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  constexpr Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+  auto bits = std::bit_cast<Key>(value);
+  if constexpr (std::is_floating_point_v<T>) {
+    // negative values are ordered reversely by their bits
+    return (bits & sign) != 0 ? static_cast<Key>(~bits) : static_cast<Key>(bits | sign);
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<Key>(bits ^ sign);
+  } else {
+    return bits;
+  }
+}
+
+/**
+ * @brief Parallel least significant digit radix sort on 8 bit digits of radix_key. Every one of num_threads threads
+ *  must call operator()(thread_id). Per digit, the threads count the digits of their partition, derive their output
+ *  offsets from the counts of all threads and scatter their partition stably into the other buffer. Digits that are
+ *  equal for all elements are skipped.
+ */
+template <typename T>
+  requires IsRadixSortable<T>
+class RadixSort {
+ public:
+  /**
+   * @param data
+   * @param size
+   * @param buffer scratch memory of size elements
+   * @param num_threads
+   */
+  RadixSort(T* data, size_t size, T* buffer, size_t num_threads)
+      : _data(data),
+        _size(size),
+        _buffer(buffer),
+        _num_threads(num_threads),
+        _barrier(static_cast<std::ptrdiff_t>(num_threads)),
+        _histograms(num_threads) {}
+
+  void operator()(size_t thread_id) {
+    auto [begin, end] = utils::partition(_size, thread_id, _num_threads);
+    T* src = _data;
+    T* dst = _buffer;
+    for (unsigned shift = 0; shift < sizeof(T) * 8; shift += 8) {
+      auto& histogram = _histograms[thread_id];
+      histogram.fill(0);
+      for (size_t i = begin; i < end; ++i) {
+        ++histogram[(radix_key(src[i]) >> shift) & 0xff];
+      }
+      _barrier.arrive_and_wait();
+
+      // elements with digit d of this thread follow all smaller digits and digit d of the threads before
+      std::array<size_t, 256> offsets;
+      size_t total = 0;
+      bool skip = false;
+      for (size_t d = 0; d < 256; ++d) {
+        size_t digit_total = 0;
+        offsets[d] = total;
+        for (size_t t = 0; t < _num_threads; ++t) {
+          if (t < thread_id) {
+            offsets[d] += _histograms[t][d];
+          }
+          digit_total += _histograms[t][d];
+        }
+        skip |= digit_total == _size;
+        total += digit_total;
+      }
+      if (!skip) {
+        for (size_t i = begin; i < end; ++i) {
+          dst[offsets[(radix_key(src[i]) >> shift) & 0xff]++] = src[i];
+        }
+      }
+      _barrier.arrive_and_wait();
+      if (!skip) {
+        std::swap(src, dst);
+      }
+    }
+    if (src != _data) {
+      std::copy(src + begin, src + end, _data + begin);
+    }
+  }
+
+ private:
+  T* _data;
+  size_t _size;
+  T* _buffer;
+  size_t _num_threads;
+  std::barrier<> _barrier;
+  std::vector<std::array<size_t, 256>> _histograms;
+};
+
+/**
+ * @brief Payload sizes (bytes) of the record sort benchmarks
+ */
+inline constexpr std::array<size_t, 4> record_payloads{16, 32, 64, 128};
+
+/**
+ * @brief Record of a key and Payload bytes of payload, ordered by key (array of structs layout)
+ */
+template <size_t Payload>
+struct Record {
+  uint64_t key;
+  std::array<char, Payload> payload;
+
+  auto operator<=>(const Record& other) const { return key <=> other.key; }
+};
+
+/**
+ * @brief Key of a record and the position of the record, ordered by key
+ */
+struct KeyIndex {
+  uint64_t key;
+  uint64_t index;
+
+  auto operator<=>(const KeyIndex& other) const { return key <=> other.key; }
+};
+
+/**
+ * @brief Sort records by key, moving the whole records
+ */
+template <size_t Payload>
+void sort_records(Record<Payload>* records, size_t size) {
+  sort(records, size);
+}
+
+/**
+ * @brief Sort the keys of records with their indices and gather the records into output in key order
+ * @param index scratch memory of size elements
+ */
+template <size_t Payload>
+void sort_records_by_index(const Record<Payload>* records, size_t size, KeyIndex* index, Record<Payload>* output) {
+  for (size_t i = 0; i < size; ++i) {
+    index[i] = {records[i].key, i};
+  }
+  sort(index, size);
+  for (size_t i = 0; i < size; ++i) {
+    output[i] = records[index[i].index];
+  }
+}
+
+/**
+ * @brief Sort records stored as struct of arrays (keys and Payload bytes per record in payloads) by key: the keys are
+ *  sorted with their indices, then keys and payloads are gathered into keys_out and payloads_out
+ * @param index scratch memory of size elements
+ */
+template <size_t Payload>
+void sort_columns(const uint64_t* keys, const char* payloads, size_t size, KeyIndex* index, uint64_t* keys_out,
+                  char* payloads_out) {
+  for (size_t i = 0; i < size; ++i) {
+    index[i] = {keys[i], i};
+  }
+  sort(index, size);
+  for (size_t i = 0; i < size; ++i) {
+    keys_out[i] = index[i].key;
+    std::memcpy(payloads_out + i * Payload, payloads + index[i].index * Payload, Payload);
+  }
+}
+
 }  // namespace taskbench::cpu::sort
\ No newline at end of file
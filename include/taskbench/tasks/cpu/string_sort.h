@@ -0,0 +1,74 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace taskbench::cpu::string_sort {
+
+/**
+ * @brief Reference to a string stored contiguously with other strings (e.g. in a StringArena). The first 8 characters
+ *  are stored in the handle (big endian, zero padded) so that most comparisons do not access the characters.
+ */
+struct Handle {
+  uint64_t prefix;
+  uint64_t offset;
+  uint64_t length;
+};
+
+/**
+ * @brief Handle of the string chars[offset, offset + length)
+ */
+Handle make_handle(const char* chars, uint64_t offset, uint64_t length);
+
+/**
+ * @brief Strings stored back to back in a single buffer and referenced by handles
+ */
+class StringArena {
+ public:
+  void reserve(size_t num_strings, size_t num_chars);
+  void add(std::string_view str);
+
+  [[nodiscard]] std::string_view view(const Handle& handle) const;
+  [[nodiscard]] const char* chars() const;
+  [[nodiscard]] const std::vector<Handle>& handles() const;
+  [[nodiscard]] size_t num_chars() const;
+
+ private:
+  std::vector<char> _chars;
+  std::vector<Handle> _handles;
+};
+
+/**
+ * @brief Lexicographic comparison of the strings of a and b (characters compared as unsigned char like std::string)
+ * @return true if a is less than b
+ */
+bool less(const Handle& a, const Handle& b, const char* chars);
+
+/**
+ * @brief std::sort of handles using less
+ */
+void std_sort(Handle* handles, size_t size, const char* chars);
+
+/**
+ * @brief Multikey quicksort (Bentley, Sedgewick): ternary partitioning on a single character per level, equal
+ *  partitions continue with the next character
+ */
+void multikey_quicksort(Handle* handles, size_t size, const char* chars);
+
+/**
+ * @brief Most significant digit radix sort on single characters, small buckets and buckets past a fixed depth (long
+ *  common prefixes) are finished by multikey quicksort
+ * @param buffer scratch memory of size handles
+ */
+void msd_radix_sort(Handle* handles, size_t size, const char* chars, Handle* buffer);
+
+}  // namespace taskbench::cpu::string_sort
\ No newline at end of file
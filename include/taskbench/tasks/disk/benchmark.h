@@ -0,0 +1,48 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <taskbench/benchmark.h>
+#include <taskbench/tasks/disk/external_sort.h>
+
+#include <filesystem>
+#include <string>
+
+namespace taskbench::disk {
+
+class Benchmark : public AbstractBenchmark {
+ public:
+  Benchmark() = default;
+  ~Benchmark() override = default;
+
+  void run_all(seconds runtime) override;
+
+  /**
+   * @brief Sort a generated file of uint64_t of four times the memory budget with ExternalSort (runs sorted by all
+   *  threads, spilled to the configured directory and merged). Reported as GiB/s of sorted data, the mean run
+   *  generation and merge times are written to the parameters of the result. The files may be served by the page cache
+   *  if they fit into the physical memory.
+   */
+  void run_external_sort(seconds runtime);
+
+  /**
+   * @brief Set the directory of the input, output and run files of the external sort (default: temp directory)
+   */
+  void set_directory(std::filesystem::path directory);
+
+  /**
+   * @brief Set the bytes of data buffers the external sort may use at once
+   */
+  void set_memory_budget(uint64_t bytes);
+
+ private:
+  std::filesystem::path _directory{std::filesystem::temp_directory_path()};
+  uint64_t _memory_budget = S_128_MiB;
+};
+
+}  // namespace taskbench::disk
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <taskbench/utils/buffer.h>
+#include <taskbench/utils/worker_pool.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace taskbench::disk {
+
+/**
+ * @brief Temporary files that are removed on destruction, i.e. also if the code creating or using them throws
+ */
+class TemporaryFiles {
+ public:
+  TemporaryFiles() = default;
+  TemporaryFiles(const TemporaryFiles&) = delete;
+  TemporaryFiles(TemporaryFiles&& other) noexcept;
+  TemporaryFiles& operator=(const TemporaryFiles&) = delete;
+  TemporaryFiles& operator=(TemporaryFiles&& other) noexcept;
+  ~TemporaryFiles();
+
+  /**
+   * @brief Take ownership of path (the file does not need to exist yet)
+   * @return path
+   */
+  const std::filesystem::path& add(std::filesystem::path path);
+
+  /**
+   * @brief Remove all files, errors are ignored
+   */
+  void clear() noexcept;
+
+  [[nodiscard]] const std::vector<std::filesystem::path>& paths() const;
+  [[nodiscard]] size_t size() const;
+
+ private:
+  std::vector<std::filesystem::path> _paths;
+};
+
+/**
+ * @brief Time spent in the phases of an ExternalSort
+ */
+struct ExternalSortStats {
+  std::chrono::duration<double> run_generation{0};
+  std::chrono::duration<double> merge{0};
+  size_t num_runs{0};
+  size_t num_merge_passes{0};
+  // pages that back the chunks of the run generation (may be weaker than the requested mode)
+  utils::PageMode page_mode{utils::PageMode::DEFAULT};
+};
+
+/**
+ * @brief Sort a binary file of uint64_t that does not fit into the memory budget:
+ *  1. run generation: chunks of a quarter of the budget are sorted by cpu::sort::SampleSort on all workers of the pool
+ *     and spilled to run files. Reading the next chunk and writing the previous run overlap with sorting.
+ *  2. merge: the runs are k-way merged with double buffered asynchronous reads of every run and asynchronous writes of
+ *     the output. If the read buffers of all runs exceed the budget, runs are merged in several passes.
+ */
+class ExternalSort {
+ public:
+  /**
+   * @param directory location of the run files
+   * @param memory_budget bytes of data buffers used at once
+   * @param pool workers sorting the runs
+   * @param page_mode pages of the data buffers, which are leased from utils::BufferPool::global()
+   */
+  ExternalSort(std::filesystem::path directory, size_t memory_budget, utils::WorkerPool& pool,
+               utils::PageMode page_mode = utils::PageMode::DEFAULT);
+
+  /**
+   * @brief Sort the uint64_t of input into output. Throws std::runtime_error on I/O errors.
+   */
+  ExternalSortStats operator()(const std::filesystem::path& input, const std::filesystem::path& output);
+
+  /**
+   * @brief Write size uniformly distributed uint64_t to path (see utils::DataGenerator)
+   */
+  static void generate(const std::filesystem::path& path, size_t size, unsigned seed);
+
+  // smallest read buffer of a run while merging (elements)
+  static constexpr size_t min_block_size = 1 << 15;
+
+ private:
+  TemporaryFiles _generate_runs(const std::filesystem::path& input, ExternalSortStats& stats);
+  void _merge(const std::vector<std::filesystem::path>& runs, const std::filesystem::path& output) const;
+  [[nodiscard]] std::filesystem::path _run_path(size_t pass, size_t run) const;
+
+  std::filesystem::path _directory;
+  size_t _memory_budget;
+  utils::WorkerPool& _pool;
+  utils::PageMode _page_mode;
+};
+
+}  // namespace taskbench::disk
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace taskbench::ram {
 
@@ -31,8 +32,76 @@ class Benchmark : public AbstractBenchmark {
   void run_write(seconds runtime);
   void run_read_write(seconds runtime);
 
+  /**
+   * @brief STREAM Copy, Scale, Add and Triad on three double arrays of a quarter of the buffer size each. The arrays
+   *  are first touched by the threads that process them and bandwidth is counted like STREAM does (two arrays for Copy
+   *  and Scale, three for Add and Triad, no write allocate traffic).
+   */
+  void run_stream(seconds runtime);
+
+  /**
+   * @brief Random 8 byte and 64 byte (cache line) reads and writes within the buffer at positions given by a
+   *  precomputed uniformly distributed index array. The index array is partitioned among the threads, every thread may
+   *  access the whole buffer. Reported as GiB/s of accessed data and accesses per second.
+   */
+  void run_random_access(seconds runtime);
+
+  /**
+   * @brief Read one 8 byte word every stride bytes of the buffer for strides from 8 B to 4 KiB. The strides are written
+   *  to the "sweep" of the result ("bps" counts the bytes loaded, i.e. 8 per access), the result itself is stride 64 B.
+   */
+  void run_strided(seconds runtime);
+
+  /**
+   * @brief Measure the latency of dependent loads by chasing a randomly permuted chain of cache line sized nodes. The
+   *  latency is measured for working sets from 4 KiB to the buffer size (or the configured working set sweep) and
+   *  reported as time per load.
+   */
+  void run_latency(seconds runtime);
+
+  /**
+   * @brief Measure the latency of a pointer chasing probe (thread 0) while the remaining threads (at least one) stream
+   *  reads or writes over the buffer. The load threads pause for a delay after every 64 KiB chunk; the delay is swept
+   *  from 0 (saturated memory bus) to 200 us. Every sweep point holds the probe latency and the bandwidth achieved by
+   *  the load threads at the same time. The result itself is the latency at the highest load.
+   */
+  void run_loaded_latency(seconds runtime);
+
+  /**
+   * @brief Additionally run the latency benchmark on memory backed by transparent huge pages (utils::PageMode::THP) to
+   *  separate the cost of TLB misses from the cost of cache misses (Linux only)
+   */
+  void set_huge_pages(bool enabled);
+
+  /**
+   * @brief Additionally measure read, write and read_write for working sets from min_size to max_size bytes (log scale)
+   *  to expose the bandwidth of each cache level. The curve is written to the "sweep" of the results. The sweep runs on
+   *  a single thread so that the cache level boundaries do not move with the number of threads.
+   * @param min_size smallest working set in bytes (0 disables the sweep)
+   * @param max_size largest working set in bytes, limited to half of the physical memory
+   * @param points_per_octave number of working set sizes per doubling of the size
+   */
+  void set_working_set_sweep(uint64_t min_size = S_4_KiB, uint64_t max_size = S_4_GiB, size_t points_per_octave = 2);
+
  private:
+  /**
+   * @brief Working set sizes of the configured sweep (empty if the sweep is disabled)
+   */
+  [[nodiscard]] std::vector<uint64_t> _working_set_sizes() const;
+
+  /**
+   * @brief Number of passes over a working set executed by a single run of a sweep
+   */
+  static size_t _sweep_passes(uint64_t working_set);
+
+  // threads of the working set sweep: a working set shared by several threads would shrink per thread
+  static constexpr size_t sweep_threads = 1;
+
   uint64_t _buffer_size = S_512_MiB;
+  uint64_t _sweep_min_size = 0;
+  uint64_t _sweep_max_size = 0;
+  size_t _sweep_points_per_octave = 2;
+  bool _huge_pages = false;
 };
 
 }  // namespace taskbench::ram
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace taskbench::ram {
+
+/**
+ * @brief Instruction families the RAM kernels (read, write, read_write) are implemented with
+ */
+enum class Kernel {
+  // 8 byte loads/stores through volatile pointers (neither vectorized nor replaced by libc calls)
+  SCALAR,
+  // 16 byte loads/stores
+  SSE2,
+  // 32 byte loads/stores
+  AVX2,
+  // 64 byte loads/stores
+  AVX512,
+  // 16 byte non-temporal (streaming) stores that bypass the caches and avoid the read for ownership
+  SSE2_NT,
+  // 32 byte non-temporal stores
+  AVX2_NT,
+  // 64 byte non-temporal stores
+  AVX512_NT,
+  // rep movsb/stosb (microcoded string instructions)
+  REP
+};
+
+std::string to_string(Kernel kernel);
+
+/**
+ * @brief Check via CPUID if the cpu (and operating system) supports the instructions of kernel
+ * @param kernel
+ * @return
+ */
+bool is_supported(Kernel kernel);
+
+/**
+ * @brief Byte wise stores (through a volatile pointer) for the parts of a buffer that do not fill a whole (aligned)
+ *  vector
+ */
+void fill_bytes(char* data, size_t size, char value);
+
+/**
+ * @brief Byte wise copy (through volatile pointers) of the parts of a buffer that do not fill a whole (aligned) vector
+ */
+void copy_bytes(const char* src, char* dst, size_t size);
+
+/**
+ * @brief Number of bytes until data is aligned to alignment (limited to size)
+ */
+size_t head_size(const char* data, size_t size, size_t alignment);
+
+}  // namespace taskbench::ram
\ No newline at end of file
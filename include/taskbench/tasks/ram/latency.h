@@ -0,0 +1,50 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <taskbench/utils/data_generator.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace taskbench::ram::latency {
+
+/**
+ * @brief Node of a pointer chain occupying exactly one cache line
+ */
+typedef utils::Node<std::array<char, 64 - sizeof(void*)>> Node;
+
+static_assert(sizeof(Node) == 64, "latency::Node must occupy exactly one cache line");
+
+/**
+ * @brief Link nodes to a single cycle in random order so that every load depends on the previous one and can not be
+ *  predicted by hardware prefetchers
+ * @param nodes
+ * @param num_nodes
+ * @param seed
+ * @return first node of the cycle
+ */
+Node* build_chain(Node* nodes, size_t num_nodes, unsigned seed);
+
+/**
+ * @brief Follow a pointer chain for num_loads dependent loads
+ * @param node
+ * @param num_loads
+ * @return the node reached after num_loads loads
+ */
+const Node* chase(const Node* node, size_t num_loads);
+
+/**
+ * @brief Busy wait for the given time. Used to throttle the load generating threads of the loaded latency benchmark
+ *  without giving up their cores.
+ * @param delay
+ */
+void spin(std::chrono::nanoseconds delay);
+
+}  // namespace taskbench::ram::latency
\ No newline at end of file
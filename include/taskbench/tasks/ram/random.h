@@ -0,0 +1,49 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace taskbench::ram::random {
+
+/**
+ * @brief A single cache line
+ */
+struct alignas(64) Line {
+  uint64_t words[8];
+};
+
+/**
+ * @brief Load the 8 byte words data[indices[i]]. The loads are independent of each other so that the cpu can keep
+ *  multiple misses in flight.
+ * @param data
+ * @param indices
+ * @param num_indices
+ * @return xor of the loaded words
+ */
+uint64_t read(const uint64_t* data, const uint64_t* indices, size_t num_indices);
+
+/**
+ * @brief Load the whole cache lines data[indices[i]]
+ * @return xor of the loaded words
+ */
+uint64_t read_lines(const Line* data, const uint64_t* indices, size_t num_indices);
+
+/**
+ * @brief Store value to the 8 byte words data[indices[i]]. Stores are relaxed atomics (plain stores on x86) because
+ *  threads may hit the same word.
+ */
+void write(uint64_t* data, const uint64_t* indices, size_t num_indices, uint64_t value);
+
+/**
+ * @brief Store value to every word of the cache lines data[indices[i]]
+ */
+void write_lines(Line* data, const uint64_t* indices, size_t num_indices, uint64_t value);
+
+}  // namespace taskbench::ram::random
\ No newline at end of file
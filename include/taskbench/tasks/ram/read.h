@@ -7,19 +7,39 @@
 
 #pragma once
 
-#include <taskbench/utils/data_generator.h>
+#include <taskbench/tasks/ram/kernel.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace taskbench::ram::read {
 
 /**
- * @brief
- * @param fst
- * @param snd
- * @param size
+ * @brief Read size bytes starting at data and return the xor of all loaded 8 byte words (the tail is added byte wise)
  */
-void sequential(const char* data, size_t size);
+typedef uint64_t (*Function)(const char* data, size_t size);
+
+/**
+ * @brief Read kernels supported by the cpu (Kernel::SCALAR, SSE2, AVX2 and AVX512)
+ * @return
+ */
+std::vector<Kernel> kernels();
+
+/**
+ * @brief Get the read function of kernel
+ * @param kernel
+ * @return
+ * @throws std::runtime_error if the kernel is not supported by the cpu or not implemented for reading
+ */
+Function get(Kernel kernel);
+
+/**
+ * @brief Read data using the widest loads supported by the cpu
+ * @param data
+ * @param size number of bytes
+ * @return xor of the loaded data
+ */
+uint64_t sequential(const char* data, size_t size);
 
 }  // namespace taskbench::ram::read
\ No newline at end of file
@@ -7,10 +7,38 @@
 
 #pragma once
 
+#include <taskbench/tasks/ram/kernel.h>
+
 #include <cstddef>
+#include <vector>
 
 namespace taskbench::ram::read_write {
 
-void sequential(const int* src, int* dst, size_t size);
+/**
+ * @brief Copy size bytes from src to dst
+ */
+typedef void (*Function)(const char* src, char* dst, size_t size);
+
+/**
+ * @brief Copy kernels supported by the cpu (every Kernel may be used for copying, _NT kernels only affect the stores)
+ * @return
+ */
+std::vector<Kernel> kernels();
+
+/**
+ * @brief Get the copy function of kernel
+ * @param kernel
+ * @return
+ * @throws std::runtime_error if the kernel is not supported by the cpu
+ */
+Function get(Kernel kernel);
+
+/**
+ * @brief Copy src to dst using the widest regular (cached) loads and stores supported by the cpu
+ * @param src
+ * @param dst
+ * @param size number of bytes
+ */
+void sequential(const char* src, char* dst, size_t size);
 
 }  // namespace taskbench::ram::read_write
\ No newline at end of file
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace taskbench::ram::stream {
+
+/**
+ * @brief c[i] = a[i]
+ */
+void copy(const double* a, double* c, size_t size);
+
+/**
+ * @brief b[i] = scalar * c[i]
+ */
+void scale(double* b, const double* c, double scalar, size_t size);
+
+/**
+ * @brief c[i] = a[i] + b[i]
+ */
+void add(const double* a, const double* b, double* c, size_t size);
+
+/**
+ * @brief a[i] = b[i] + scalar * c[i]
+ */
+void triad(double* a, const double* b, const double* c, double scalar, size_t size);
+
+}  // namespace taskbench::ram::stream
\ No newline at end of file
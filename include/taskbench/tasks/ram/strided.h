@@ -0,0 +1,24 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace taskbench::ram::strided {
+
+/**
+ * @brief Load one 8 byte word every stride bytes of data
+ * @param data
+ * @param size number of bytes
+ * @param stride distance of two loads in bytes (multiple of 8)
+ * @return xor of the loaded words
+ */
+uint64_t read(const char* data, size_t size, size_t stride);
+
+}  // namespace taskbench::ram::strided
\ No newline at end of file
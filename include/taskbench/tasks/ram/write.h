@@ -7,10 +7,38 @@
 
 #pragma once
 
+#include <taskbench/tasks/ram/kernel.h>
+
 #include <cstddef>
+#include <vector>
 
 namespace taskbench::ram::write {
 
-void sequential(int* buffer, size_t size, int value);
+/**
+ * @brief Set size bytes starting at data to value
+ */
+typedef void (*Function)(char* data, size_t size, char value);
+
+/**
+ * @brief Write kernels supported by the cpu (every Kernel may be used for writing)
+ * @return
+ */
+std::vector<Kernel> kernels();
+
+/**
+ * @brief Get the write function of kernel
+ * @param kernel
+ * @return
+ * @throws std::runtime_error if the kernel is not supported by the cpu
+ */
+Function get(Kernel kernel);
+
+/**
+ * @brief Write data using the widest regular (cached) stores supported by the cpu
+ * @param data
+ * @param size number of bytes
+ * @param value
+ */
+void sequential(char* data, size_t size, char value);
 
 }  // namespace taskbench::ram::write
\ No newline at end of file
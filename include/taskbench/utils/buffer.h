@@ -0,0 +1,214 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Pages backing the memory of a Buffer
+ */
+enum class PageMode {
+  // whatever the operating system does by default (on Linux depends on the transparent huge page setting)
+  DEFAULT,
+  // regular 4 KiB pages, transparent huge pages are disabled for the buffer (madvise(MADV_NOHUGEPAGE))
+  SMALL,
+  // transparent huge pages (madvise(MADV_HUGEPAGE))
+  THP,
+  // explicit 2 MiB huge pages (mmap(MAP_HUGETLB)), requires pages reserved in /proc/sys/vm/nr_hugepages
+  HUGETLB_2MiB,
+  // explicit 1 GiB huge pages (mmap(MAP_HUGETLB))
+  HUGETLB_1GiB
+};
+
+std::string to_string(PageMode mode);
+
+/**
+ * @brief Untyped page aligned memory backed by pages of a given PageMode.
+ *
+ * If the requested pages are not available, the allocation falls back to the next weaker mode (1 GiB -> 2 MiB -> THP).
+ * The mode that was actually used is returned by page_mode(). Page modes are only supported on Linux, other platforms
+ * always use PageMode::DEFAULT. The memory is not touched by the allocation.
+ */
+class RawBuffer {
+ public:
+  RawBuffer() = default;
+  RawBuffer(size_t bytes, PageMode mode);
+  ~RawBuffer();
+
+  RawBuffer(const RawBuffer&) = delete;
+  RawBuffer& operator=(const RawBuffer&) = delete;
+  RawBuffer(RawBuffer&& other) noexcept;
+  RawBuffer& operator=(RawBuffer&& other) noexcept;
+
+  [[nodiscard]] void* data() const;
+  [[nodiscard]] size_t bytes() const;
+  [[nodiscard]] PageMode page_mode() const;
+  [[nodiscard]] PageMode requested_page_mode() const;
+
+ private:
+  void _release();
+
+  void* _data{nullptr};
+  size_t _bytes{0};
+  // size of the mapping (rounded up to whole pages)
+  size_t _mapped_bytes{0};
+  PageMode _page_mode{PageMode::DEFAULT};
+  PageMode _requested_page_mode{PageMode::DEFAULT};
+};
+
+/**
+ * @brief Thrown by BufferPool::acquire if a lease would exceed the memory budget of the pool. Benchmarks are skipped
+ *  instead of aborted on it (see AbstractBenchmark::_run_within_budget).
+ */
+class BudgetExceeded : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Process wide cache of RawBuffers with a memory budget.
+ *
+ * Benchmarks lease their buffers from the pool. Returned buffers are kept and handed out again for later requests of
+ * the same page mode that fit into them, so consecutive benchmarks reuse memory instead of mapping new pages. If no
+ * cached buffer fits, all cached buffers are unmapped before new memory is mapped. Leases that exceed the budget throw
+ * BudgetExceeded.
+ */
+class BufferPool {
+ public:
+  /**
+   * @brief The pool shared by all benchmarks
+   */
+  static BufferPool& global();
+
+  /**
+   * @brief Limit the bytes leased and cached by the pool (0: unlimited). Cached buffers beyond the budget are unmapped.
+   */
+  void set_budget(size_t bytes);
+  [[nodiscard]] size_t budget() const;
+
+  /**
+   * @brief Lease a buffer of at least bytes bytes
+   * @param bytes
+   * @param mode
+   * @param fresh do not reuse a cached buffer: the pages are not mapped yet and will be mapped by the first thread
+   *  touching them (e.g. to place them on the NUMA node of that thread or to include page faults into a measurement)
+   * @return
+   */
+  RawBuffer acquire(size_t bytes, PageMode mode, bool fresh = false);
+
+  /**
+   * @brief Return a leased buffer to the pool
+   */
+  void release(RawBuffer buffer);
+
+  /**
+   * @brief Unmap all cached buffers
+   */
+  void clear();
+
+  [[nodiscard]] size_t leased_bytes() const;
+  [[nodiscard]] size_t cached_bytes() const;
+
+ private:
+  void _shrink();
+
+  mutable std::mutex _mutex;
+  size_t _budget{0};
+  size_t _leased_bytes{0};
+  size_t _cached_bytes{0};
+  // cached buffers (the requested page mode and the buffer)
+  std::vector<std::pair<PageMode, RawBuffer>> _cache;
+};
+
+/**
+ * @brief Fixed size array of T backed by a RawBuffer. Trivial types are left uninitialized so that the pages are mapped
+ *  by the thread that writes to them first (unless the memory was leased from a BufferPool and reused).
+ */
+template <typename T>
+  requires std::is_trivially_destructible_v<T>
+class Buffer {
+ public:
+  Buffer() = default;
+  explicit Buffer(size_t size, PageMode mode = PageMode::DEFAULT)
+      : Buffer(RawBuffer(std::max<size_t>(size, 1) * sizeof(T), mode), size) {}
+
+  /**
+   * @brief Lease the memory from pool, it is returned on destruction
+   */
+  Buffer(size_t size, PageMode mode, BufferPool& pool, bool fresh = false)
+      : Buffer(pool.acquire(std::max<size_t>(size, 1) * sizeof(T), mode, fresh), size) {
+    _pool = &pool;
+  }
+
+  ~Buffer() { _release(); }
+
+  Buffer(const Buffer&) = delete;
+  Buffer& operator=(const Buffer&) = delete;
+  Buffer(Buffer&& other) noexcept
+      : _raw(std::move(other._raw)), _size(std::exchange(other._size, 0)), _pool(std::exchange(other._pool, nullptr)) {}
+  Buffer& operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+      _release();
+      _raw = std::move(other._raw);
+      _size = std::exchange(other._size, 0);
+      _pool = std::exchange(other._pool, nullptr);
+    }
+    return *this;
+  }
+
+  T* data() { return static_cast<T*>(_raw.data()); }
+  const T* data() const { return static_cast<const T*>(_raw.data()); }
+
+  T& operator[](size_t i) { return data()[i]; }
+  const T& operator[](size_t i) const { return data()[i]; }
+
+  T* begin() { return data(); }
+  T* end() { return data() + _size; }
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + _size; }
+
+  [[nodiscard]] size_t size() const { return _size; }
+  [[nodiscard]] size_t bytes() const { return _size * sizeof(T); }
+
+  /**
+   * @brief Page mode that backs the buffer (may be weaker than the requested mode, see RawBuffer)
+   */
+  [[nodiscard]] PageMode page_mode() const { return _raw.page_mode(); }
+
+ private:
+  Buffer(RawBuffer raw, size_t size) : _raw(std::move(raw)), _size(size) {
+    if constexpr (!std::is_trivially_default_constructible_v<T>) {
+      std::uninitialized_default_construct_n(data(), _size);
+    }
+  }
+
+  void _release() {
+    if (_pool != nullptr && _raw.data() != nullptr) {
+      _pool->release(std::move(_raw));
+    }
+    _raw = RawBuffer();
+    _pool = nullptr;
+    _size = 0;
+  }
+
+  RawBuffer _raw;
+  size_t _size{0};
+  BufferPool* _pool{nullptr};
+};
+
+}  // namespace taskbench::utils
\ No newline at end of file
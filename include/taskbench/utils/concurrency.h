@@ -0,0 +1,43 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Limits on the number of cpus the process can use. A value of 0 means that the limit is not set or could not be
+ *  determined on the current platform.
+ */
+struct ConcurrencyLimits {
+  // std::thread::hardware_concurrency()
+  size_t hardware{0};
+  // number of cpus in the affinity mask of the process (sched_getaffinity)
+  size_t affinity{0};
+  // number of cpus in the cgroup cpuset (cpuset.cpus.effective)
+  size_t cpuset{0};
+  // cgroup CPU bandwidth limit in cpus (cpu.max on cgroup v2, cpu.cfs_quota_us / cpu.cfs_period_us on cgroup v1)
+  double cpu_quota{0};
+  // number of threads a benchmark should use: the tightest of the limits above (quota rounded up), at least 1
+  size_t effective{1};
+};
+
+/**
+ * @brief Detect the concurrency limits of the calling process
+ * @return
+ */
+ConcurrencyLimits detect_concurrency();
+
+/**
+ * @brief Default number of threads for multi threaded benchmarks (ConcurrencyLimits::effective, detected once)
+ * @return
+ */
+size_t default_concurrency();
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TASKBENCH_X86 1
+#endif
+
+// Functions using instructions beyond the baseline of the build are compiled for their instruction set individually and
+// must only be called after checking CpuFeatures at runtime.
+#if defined(TASKBENCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TASKBENCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TASKBENCH_TARGET(isa)
+#endif
+
+namespace taskbench::utils {
+
+/**
+ * @brief Instruction set extensions of the cpu that are also enabled by the operating system (checked via CPUID and
+ *  XGETBV). All values are false on non x86 platforms.
+ */
+struct CpuFeatures {
+  bool sse2{false};
+  bool avx2{false};
+  // AVX-512 foundation
+  bool avx512f{false};
+  // enhanced rep movsb/stosb
+  bool erms{false};
+  // fast short rep movsb
+  bool fsrm{false};
+  // AES round instructions and carry-less multiplication on 128 bit registers (with SSSE3)
+  bool aesni{false};
+  bool pclmulqdq{false};
+  // AES round instructions and carry-less multiplication on 256 bit registers (with AVX2)
+  bool vaes{false};
+  bool vpclmulqdq{false};
+  // time stamp counter ticking at a constant rate regardless of frequency scaling and sleep states
+  bool invariant_tsc{false};
+};
+
+/**
+ * @brief Detect the features of the cpu (once on first use)
+ * @return
+ */
+const CpuFeatures& cpu_features();
+
+/**
+ * @brief Ticks per second of the invariant time stamp counter, calibrated against std::chrono::steady_clock once on
+ *  first use. The counter ticks at the nominal frequency of the cpu: cycles derived from it are reference cycles, not
+ *  core cycles at the current (turbo) frequency.
+ * @return 0 if there is no invariant time stamp counter
+ */
+double tsc_frequency();
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -9,7 +9,13 @@
 
 #include <taskbench/utils/concepts.h>
 
-#include <random>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -23,39 +29,219 @@ struct Node {
   Node<T>* next{nullptr};
 };
 
+/**
+ * @brief Distribution of generated values in [min, max]
+ */
+enum class Distribution {
+  UNIFORM,
+  // value min + k - 1 with probability proportional to 1 / k^s (parameter: s)
+  ZIPF,
+  // uniform values in ascending order
+  SORTED,
+  // uniform values in descending order
+  REVERSE_SORTED,
+  // sorted values, parameter percent of them are swapped with random positions
+  NEARLY_SORTED,
+  // uniform values drawn from a set of parameter distinct values
+  FEW_UNIQUE
+};
+
+std::string to_string(Distribution distribution);
+
+/**
+ * @brief Parameter used for distribution if none is given (1.0 for ZIPF and NEARLY_SORTED, 16 for FEW_UNIQUE)
+ */
+double default_parameter(Distribution distribution);
+
+namespace rng {
+
+// elements per block of parallel_for (a multiple of every vector width)
+inline constexpr size_t block_size = 1 << 14;
+
+/**
+ * @brief Key of the random stream of seed
+ */
+inline uint64_t key(uint64_t seed) {
+  uint64_t z = seed ^ 0x6a09e667f3bcc909;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief index-th word of the random stream of key (SplitMix64). Words are counter based: they only depend on key and
+ *  index, so any part of a stream can be generated independently of the others.
+ */
+inline uint64_t word(uint64_t key, uint64_t index) {
+  uint64_t z = key + (index + 1) * 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Fill out with the words [index, index + size) of the stream of key mapped to [0, range) (range 0: all 64 bit
+ *  values)
+ */
+void fill(uint64_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range);
+
+/**
+ * @brief Fill out with the words [index, index + size) of the stream of key mapped to [0, range), range in [1, 2^32]
+ */
+void fill(uint32_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range);
+
+/**
+ * @brief Fill out with the words [index, index + size) of the stream of key mapped to [min, max)
+ */
+void fill(double* out, size_t size, uint64_t key, uint64_t index, double min, double max);
+void fill(float* out, size_t size, uint64_t key, uint64_t index, float min, float max);
+
+/**
+ * @brief Fill out with the elements [index, index + size) of a dataset of total elements following distribution as
+ *  offsets in [0, range) (range 0: all 64 bit values). NEARLY_SORTED datasets are generated sorted, the swaps depend on
+ *  each other and are applied by DataGenerator afterwards.
+ */
+void fill(uint64_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range, size_t total,
+          Distribution distribution, double parameter);
+
+/**
+ * @brief Fill out with text: words of a random vocabulary of the given size are drawn from a Zipf distribution with
+ *  exponent skew and separated by spaces and punctuation. Smaller vocabularies and larger skews lower the entropy.
+ */
+void text(char* out, size_t size, uint64_t key, size_t vocabulary, double skew);
+
+/**
+ * @brief Run job(begin, end) on ranges of [0, size) in parallel. The ranges are multiples of a fixed block size so that
+ *  the vectorized fill functions above process the same elements regardless of the number of threads.
+ */
+void parallel_for(size_t size, const std::function<void(size_t, size_t)>& job);
+
+}  // namespace rng
+
+/**
+ * @brief Deterministic random benchmark data. The data only depends on the seed (not on the number of threads used to
+ *  generate it, see rng::word). Large datasets are generated in parallel using vectorized kernels.
+ */
 class DataGenerator {
  public:
   template <typename T>
     requires IsInteger<T>
   static T integer(unsigned seed, T min = std::numeric_limits<T>::min(), T max = std::numeric_limits<T>::max()) {
-    std::mt19937 rng(seed);
-    std::uniform_int_distribution<int64_t> dist(static_cast<int64_t>(min), static_cast<int64_t>(max));
-    return static_cast<T>(dist(rng));
+    T value;
+    fill(&value, 1, seed, min, max);
+    return value;
   }
 
-  template <class T>
+  /**
+   * @brief Fill data with uniformly distributed integers in [min, max]
+   */
+  template <typename T>
     requires IsInteger<T>
-  static std::vector<T> vector(size_t size, unsigned seed, T min = std::numeric_limits<T>::min(),
-                               T max = std::numeric_limits<T>::max()) {
-    std::vector<T> result(size);
-    std::mt19937 rng(seed);
-    std::uniform_int_distribution<int64_t> dist(static_cast<int64_t>(min), static_cast<int64_t>(max));
-    for (auto& i : result) {
-      i = static_cast<T>(dist(rng));
+  static void fill(T* data, size_t size, unsigned seed, T min = std::numeric_limits<T>::min(),
+                   T max = std::numeric_limits<T>::max()) {
+    uint64_t key = rng::key(seed);
+    // number of values in [min, max] (0: all 64 bit values)
+    uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min) + 1;
+    rng::parallel_for(size, [&](size_t begin, size_t end) {
+      if constexpr (sizeof(T) == sizeof(uint64_t)) {
+        auto* out = reinterpret_cast<uint64_t*>(data + begin);
+        rng::fill(out, end - begin, key, begin, range);
+        for (size_t i = 0; i < end - begin; ++i) {
+          out[i] += static_cast<uint64_t>(min);
+        }
+      } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+        auto* out = reinterpret_cast<uint32_t*>(data + begin);
+        rng::fill(out, end - begin, key, begin, range);
+        for (size_t i = 0; i < end - begin; ++i) {
+          out[i] += static_cast<uint32_t>(min);
+        }
+      } else {
+        uint32_t block[1024];
+        for (size_t i = begin; i < end; i += std::size(block)) {
+          size_t n = std::min(std::size(block), end - i);
+          rng::fill(block, n, key, i, range);
+          for (size_t j = 0; j < n; ++j) {
+            data[i + j] = static_cast<T>(static_cast<uint32_t>(min) + block[j]);
+          }
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Fill data with uniformly distributed floating points in [min, max)
+   */
+  template <typename T>
+    requires IsFloatingPoint<T>
+  static void fill(T* data, size_t size, unsigned seed, T min = std::numeric_limits<T>::min(),
+                   T max = std::numeric_limits<T>::max()) {
+    uint64_t key = rng::key(seed);
+    rng::parallel_for(size, [&](size_t begin, size_t end) {
+      if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        rng::fill(data + begin, end - begin, key, begin, min, max);
+      } else {
+        double block[1024];
+        for (size_t i = begin; i < end; i += std::size(block)) {
+          size_t n = std::min(std::size(block), end - i);
+          rng::fill(block, n, key, i, static_cast<double>(min), static_cast<double>(max));
+          std::copy_n(block, n, data + i);
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Fill data with values in [min, max] following distribution
+   * @param parameter see Distribution
+   */
+  template <typename T>
+    requires IsInteger<T> || IsFloatingPoint<T>
+  static void fill(T* data, size_t size, unsigned seed, Distribution distribution, double parameter, T min, T max) {
+    if (distribution == Distribution::UNIFORM) {
+      fill(data, size, seed, min, max);
+      return;
     }
-    return result;
+    uint64_t key = rng::key(seed);
+    // floating points are generated with a resolution of 2^32 values in [min, max)
+    uint64_t range =
+        IsFloatingPoint<T> ? uint64_t(1) << 32 : static_cast<uint64_t>(max) - static_cast<uint64_t>(min) + 1;
+    rng::parallel_for(size, [&](size_t begin, size_t end) {
+      uint64_t block[1024];
+      for (size_t i = begin; i < end; i += std::size(block)) {
+        size_t n = std::min(std::size(block), end - i);
+        rng::fill(block, n, key, i, range, size, distribution, parameter);
+        for (size_t j = 0; j < n; ++j) {
+          if constexpr (IsFloatingPoint<T>) {
+            data[i + j] = min + static_cast<T>(static_cast<double>(block[j]) * 0x1p-32 * (max - min));
+          } else {
+            data[i + j] = static_cast<T>(static_cast<uint64_t>(min) + block[j]);
+          }
+        }
+      }
+    });
+    if (distribution == Distribution::NEARLY_SORTED) {
+      uint64_t swap_key = rng::key(key);
+      auto num_swaps = static_cast<size_t>(static_cast<double>(size) * parameter / 200);
+      for (size_t i = 0; i < num_swaps; ++i) {
+        std::swap(data[rng::word(swap_key, 2 * i) % size], data[rng::word(swap_key, 2 * i + 1) % size]);
+      }
+    }
+  }
+
+  template <typename T>
+    requires IsInteger<T> || IsFloatingPoint<T>
+  static void fill(T* data, size_t size, unsigned seed, Distribution distribution,
+                   T min = IsFloatingPoint<T> ? T(0) : std::numeric_limits<T>::min(),
+                   T max = std::numeric_limits<T>::max()) {
+    fill(data, size, seed, distribution, default_parameter(distribution), min, max);
   }
 
   template <class T>
-    requires IsFloatingPoint<T>
+    requires IsInteger<T> || IsFloatingPoint<T>
   static std::vector<T> vector(size_t size, unsigned seed, T min = std::numeric_limits<T>::min(),
                                T max = std::numeric_limits<T>::max()) {
     std::vector<T> result(size);
-    std::mt19937 rng(seed);
-    std::uniform_real_distribution<T> dist(min, max);
-    for (auto& i : result) {
-      i = dist(rng);
-    }
+    fill(result.data(), size, seed, min, max);
     return result;
   }
 
@@ -63,25 +249,39 @@ class DataGenerator {
     requires std::is_same_v<T, std::string>
   static std::vector<std::string> vector(size_t size, unsigned seed, int min = 1, int max = 256) {
     std::vector<std::string> result(size);
-
-    std::mt19937 rng(seed);
-    std::uniform_int_distribution<size_t> size_dist(min, max);
-
-    for (size_t i = 0; i < size; ++i) {
-      result[i] = DataGenerator::string(size_dist(rng), static_cast<int>(i));
-    }
+    uint64_t key = rng::key(seed);
+    auto range = static_cast<uint64_t>(max - min + 1);
+    rng::parallel_for(size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        uint64_t word = rng::word(key, i);
+        size_t length = static_cast<size_t>(min) + static_cast<size_t>((word >> 32) * range >> 32);
+        result[i] = DataGenerator::string(length, static_cast<unsigned>(word));
+      }
+    });
     return result;
   }
 
+  /**
+   * @brief Fill data with text (see rng::text)
+   * @param vocabulary number of distinct words
+   * @param skew Zipf exponent of the word frequencies
+   */
+  static void text(char* data, size_t size, unsigned seed, size_t vocabulary = 4096, double skew = 1.0) {
+    rng::text(data, size, rng::key(seed), vocabulary, skew);
+  }
+
   static std::string string(size_t size, unsigned seed) {
     std::string result;
     result.resize(size);
-
-    std::mt19937 rng(seed);
-    std::uniform_int_distribution<int> dist(48, 122);
-
-    for (size_t i = 0; i < size; ++i) {
-      result[i] = static_cast<char>(dist(rng));
+    uint64_t key = rng::key(seed);
+    // printable characters in ['0', 'z']
+    uint32_t block[256];
+    for (size_t i = 0; i < size; i += std::size(block)) {
+      size_t n = std::min(std::size(block), size - i);
+      rng::fill(block, n, key, i, 'z' - '0' + 1);
+      for (size_t j = 0; j < n; ++j) {
+        result[i + j] = static_cast<char>('0' + block[j]);
+      }
     }
     return result;
   }
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Read only view of a file that is mapped into memory (on POSIX systems, other platforms read the file). The
+ *  pages are read from disk (or the page cache) when they are accessed first.
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  /**
+   * @brief Map the file at path, throws std::runtime_error if it cannot be opened or mapped
+   */
+  explicit MappedFile(std::string path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  [[nodiscard]] const char* data() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] const std::string& path() const;
+
+  /**
+   * @brief Touch all pages so that the mapping is populated before a measurement
+   */
+  void prefault() const;
+
+  /**
+   * @brief Views of the newline delimited lines of the file (without the delimiters, a trailing newline does not start
+   *  an empty line)
+   */
+  [[nodiscard]] std::vector<std::string_view> lines() const;
+
+ private:
+  void _release();
+
+  std::string _path;
+  const char* _data{nullptr};
+  size_t _size{0};
+  // copy of the file on platforms without mmap
+  std::unique_ptr<char[]> _copy;
+};
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,31 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Resident set size of the process in bytes (0 if unknown)
+ */
+size_t current_rss();
+
+/**
+ * @brief Highest resident set size of the process since start or the last call of reset_peak_rss() in bytes (0 if
+ *  unknown)
+ */
+size_t peak_rss();
+
+/**
+ * @brief Reset the peak resident set size to the current one. Only supported on Linux (via /proc/self/clear_refs),
+ *  elsewhere the peak is the one since the start of the process.
+ */
+void reset_peak_rss();
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -44,6 +45,45 @@ double mean(const std::vector<std::chrono::duration<double>>& data);
 template <>
 double stdev(const std::vector<std::chrono::duration<double>>& data);
 
+/**
+ * @brief Relative standard error of the mean (standard error divided by the mean). The standard error is based on the
+ *  sample standard deviation (n - 1), stdev() is the population standard deviation.
+ * @tparam T arithmetic type or std::chrono::duration<double>
+ * @param data
+ * @return
+ */
+template <typename T>
+double rse(const std::vector<T>& data) {
+  double m = mean(data);
+  if (data.size() < 2 || m == 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  auto n = static_cast<double>(data.size());
+  double sample_stdev = stdev(data) * std::sqrt(n / (n - 1));
+  return sample_stdev / std::sqrt(n) / m;
+}
+
+/**
+ * @brief Median of data (mean of the two middle values for an even number of values)
+ * @tparam T arithmetic type
+ * @param data copied, the order is changed while selecting the median
+ * @return
+ */
+template <typename T>
+double median(std::vector<T> data) {
+  if (data.empty()) {
+    return 0.0;
+  }
+  size_t middle = data.size() / 2;
+  std::nth_element(data.begin(), data.begin() + middle, data.end());
+  auto upper = static_cast<double>(data[middle]);
+  if (data.size() % 2 == 1) {
+    return upper;
+  }
+  auto lower = static_cast<double>(*std::max_element(data.begin(), data.begin() + middle));
+  return (lower + upper) / 2;
+}
+
 template <typename T>
 T max(const std::vector<T>& data) {
   return *std::max_element(data.begin(), data.end());
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace taskbench::utils {
+
+/**
+ * @brief A logical cpu (hardware thread) and its location within the machine
+ */
+struct Cpu {
+  int id;
+  // physical core id (unique within a package)
+  int core_id;
+  int package_id;
+  // NUMA node the cpu belongs to
+  int node_id;
+  // position among the SMT siblings of its physical core (0 for the first hardware thread)
+  int smt_index;
+};
+
+/**
+ * @brief Strategies for pinning the workers of a multi threaded benchmark to cpus
+ */
+enum class Placement {
+  // do not pin, leave placement to the scheduler
+  NONE,
+  // fill one physical core after the other, using all SMT siblings of a core first
+  COMPACT,
+  // spread threads across packages and physical cores, SMT siblings are used last
+  SCATTER,
+  // one thread per physical core
+  PHYSICAL_CORES,
+  // two threads per physical core on SMT siblings
+  SMT_PAIRS,
+  // compact placement restricted to the cpus of a single NUMA node
+  NUMA_NODE
+};
+
+std::string to_string(Placement placement);
+
+/**
+ * @brief CPU topology of the machine restricted to the cpus the process may run on.
+ *
+ * On Linux the topology is read from /sys/devices/system/cpu and /sys/devices/system/node. On other platforms every
+ * cpu is treated as an independent physical core of a single package and NUMA node.
+ */
+class Topology {
+ public:
+  /**
+   * @brief Detect the topology of the system
+   * @return
+   */
+  static Topology detect();
+
+  /**
+   * @brief Topology of the system, detected once on first use
+   * @return
+   */
+  static const Topology& system();
+
+  [[nodiscard]] const std::vector<Cpu>& cpus() const;
+
+  [[nodiscard]] size_t num_cores() const;
+  [[nodiscard]] size_t num_packages() const;
+  [[nodiscard]] size_t num_nodes() const;
+
+  /**
+   * @brief Select the cpus num_threads workers are pinned to
+   * @param placement
+   * @param num_threads
+   * @param node NUMA node used by Placement::NUMA_NODE
+   * @return cpu ids, worker i is pinned to result[i % result.size()] (empty for Placement::NONE or if the topology is
+   *  unknown). Throws std::runtime_error if the placement selects no cpu (e.g. SMT_PAIRS without SMT or a NUMA node
+   *  without usable cpus).
+   */
+  [[nodiscard]] std::vector<int> place(Placement placement, size_t num_threads, int node = 0) const;
+
+ private:
+  std::vector<Cpu> _cpus;
+};
+
+/**
+ * @brief Pin the calling thread to a single cpu. Only supported on Linux, a no-op elsewhere.
+ * @param cpu
+ * @return true if the thread was pinned
+ */
+bool pin_current_thread(int cpu);
+
+/**
+ * @brief CPUs the calling process may run on (empty if this can not be determined on the current platform)
+ * @return
+ */
+std::vector<int> available_cpus();
+
+/**
+ * @brief Parse a Linux cpu list like "0-3,8,10-11"
+ * @param list
+ * @return
+ */
+std::vector<int> parse_cpu_list(const std::string& list);
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Start and finish time of a single worker relative to the barrier release of a WorkerPool::run call
+ */
+struct WorkerTiming {
+  std::chrono::duration<double> start;
+  std::chrono::duration<double> finish;
+};
+
+/**
+ * @brief Range [first, second) of the thread_id-th of num_threads equally sized partitions of size elements. The last
+ *  partition additionally covers the remainder.
+ */
+inline std::pair<size_t, size_t> partition(size_t size, size_t thread_id, size_t num_threads) {
+  size_t partition_size = size / num_threads;
+  size_t begin = thread_id * partition_size;
+  return {begin, thread_id + 1 == num_threads ? size : begin + partition_size};
+}
+
+/**
+ * @brief Pool of persistent (optionally pinned) worker threads used by multi threaded benchmarks.
+ *
+ * Workers sleep between runs. On WorkerPool::run they are woken up, gather at a spin barrier and are released together
+ * so that thread creation and wake up latency are not part of the measured time.
+ */
+class WorkerPool {
+  typedef std::chrono::high_resolution_clock clock;
+
+ public:
+  /**
+   * @param num_threads number of workers
+   * @param cpus worker i is pinned to cpus[i % cpus.size()] (no pinning if empty)
+   */
+  explicit WorkerPool(size_t num_threads, std::vector<int> cpus = {});
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Execute job(thread_id) on all workers and wait until every worker has finished
+   * @param job
+   * @return time from the barrier release until the last worker finished
+   */
+  std::chrono::duration<double> run(const std::function<void(size_t)>& job);
+
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief CPUs the workers are pinned to (empty if workers are not pinned)
+   */
+  [[nodiscard]] const std::vector<int>& cpus() const;
+
+  /**
+   * @brief Per worker start and finish times of the last run
+   */
+  [[nodiscard]] const std::vector<WorkerTiming>& timings() const;
+
+ private:
+  void _work(size_t id);
+
+  std::vector<std::thread> _threads;
+  std::vector<int> _cpus;
+  std::vector<clock::time_point> _start_times;
+  std::vector<clock::time_point> _finish_times;
+  std::vector<WorkerTiming> _timings;
+  std::vector<std::exception_ptr> _exceptions;
+
+  const std::function<void(size_t)>* _job{nullptr};
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  uint64_t _generation{0};
+  bool _shutdown{false};
+
+  std::atomic<size_t> _ready{0};
+  std::atomic<uint64_t> _released{0};
+  std::atomic<size_t> _done{0};
+};
+
+}  // namespace taskbench::utils
\ No newline at end of file
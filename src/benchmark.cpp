@@ -8,6 +8,7 @@
 #include <fmt/color.h>
 #include <taskbench/benchmark.h>
 #include <taskbench/utils/format.h>
+#include <taskbench/utils/memory.h>
 #include <taskbench/utils/statistics.h>
 
 namespace taskbench {
@@ -58,6 +59,60 @@ double BenchmarkResult::runtime_min() const { return utils::min(_runtimes); }
 // _____________________________________________________________________________________________________________________
 const std::vector<seconds>& BenchmarkResult::runtimes() const { return _runtimes; }
 
+// _____________________________________________________________________________________________________________________
+size_t BenchmarkResult::batch_size() const { return _batch_size; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::set_batch_size(size_t batch_size) { _batch_size = batch_size; }
+
+// _____________________________________________________________________________________________________________________
+const std::vector<std::vector<utils::WorkerTiming>>& BenchmarkResult::worker_timings() const { return _worker_timings; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::add_worker_timings(const std::vector<utils::WorkerTiming>& timings) {
+  _worker_timings.push_back(timings);
+}
+
+// _____________________________________________________________________________________________________________________
+const std::vector<ScalingPoint>& BenchmarkResult::scaling() const { return _scaling; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::add_scaling_point(size_t num_threads, seconds runtime) {
+  ScalingPoint point{num_threads, runtime.count(), static_cast<double>(_data_size) / runtime.count(),
+                     static_cast<double>(_num_operations) / runtime.count(), 1.0, 1.0};
+  if (!_scaling.empty()) {
+    const auto& base = _scaling.front();
+    point.speedup = base.runtime / point.runtime;
+    point.efficiency = point.speedup * static_cast<double>(base.num_threads) / static_cast<double>(num_threads);
+  }
+  _scaling.push_back(point);
+}
+
+// _____________________________________________________________________________________________________________________
+const std::vector<SweepPoint>& BenchmarkResult::sweep() const { return _sweep; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::add_sweep_point(nlohmann::json parameters, uint64_t data_size, uint64_t num_operations,
+                                      seconds runtime) {
+  _sweep.push_back({std::move(parameters), data_size, num_operations, runtime.count(),
+                    static_cast<double>(data_size) / runtime.count(),
+                    static_cast<double>(num_operations) / runtime.count()});
+}
+
+// _____________________________________________________________________________________________________________________
+size_t BenchmarkResult::num_threads() const { return _num_threads; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::set_num_threads(size_t num_threads) { _num_threads = num_threads; }
+
+// _____________________________________________________________________________________________________________________
+const nlohmann::json& BenchmarkResult::parameters() const { return _parameters; }
+
+// _____________________________________________________________________________________________________________________
+void BenchmarkResult::set_parameter(const std::string& key, nlohmann::json value) {
+  _parameters[key] = std::move(value);
+}
+
 // _____________________________________________________________________________________________________________________
 nlohmann::json BenchmarkResult::json() {
   std::vector<double> runtimes_double(_runtimes.size());
@@ -67,7 +122,55 @@ nlohmann::json BenchmarkResult::json() {
   j["name"] = _name;
   j["data_size"] = _data_size;
   j["iterations"] = _runtimes.size();
+  j["batch_size"] = _batch_size;
+  j["threads"] = _num_threads;
   j["runtimes"] = runtimes_double;
+  if (!_parameters.empty()) {
+    j["parameters"] = _parameters;
+  }
+  if (!_worker_timings.empty()) {
+    // per worker aggregates over all samples, the timings of the single samples are available via worker_timings()
+    auto summary = [](const std::vector<double>& values) -> nlohmann::json {
+      return {{"min", *std::min_element(values.begin(), values.end())},
+              {"median", utils::median(values)},
+              {"max", *std::max_element(values.begin(), values.end())}};
+    };
+    auto& worker_timings = j["worker_timings"] = nlohmann::json::array();
+    for (size_t worker = 0; worker < _worker_timings.front().size(); ++worker) {
+      std::vector<double> starts;
+      std::vector<double> finishes;
+      for (const auto& sample : _worker_timings) {
+        starts.push_back(sample[worker].start.count());
+        finishes.push_back(sample[worker].finish.count());
+      }
+      worker_timings.push_back({{"worker", worker}, {"start", summary(starts)}, {"finish", summary(finishes)}});
+    }
+  }
+  if (!_scaling.empty()) {
+    auto& scaling = j["scaling"] = nlohmann::json::array();
+    for (const auto& point : _scaling) {
+      scaling.push_back({{"threads", point.num_threads},
+                         {"runtime", point.runtime},
+                         {"bps", point.bps},
+                         {"ops", point.ops},
+                         {"speedup", point.speedup},
+                         {"efficiency", point.efficiency}});
+    }
+  }
+  if (!_sweep.empty()) {
+    auto& sweep = j["sweep"] = nlohmann::json::array();
+    for (const auto& point : _sweep) {
+      auto point_json = point.parameters;
+      point_json["data_size"] = point.data_size;
+      point_json["runtime"] = point.runtime;
+      point_json["bps"] = point.bps;
+      point_json["ops"] = point.ops;
+      if (point.num_operations > 0) {
+        point_json["runtime_per_op"] = point.runtime / static_cast<double>(point.num_operations);
+      }
+      sweep.push_back(std::move(point_json));
+    }
+  }
   return j;
 }
 
@@ -77,6 +180,9 @@ const std::string& BenchmarkResult::name() const { return _name; }
 // _____________________________________________________________________________________________________________________
 uint64_t BenchmarkResult::data_size() const { return _data_size; }
 
+// _____________________________________________________________________________________________________________________
+uint64_t BenchmarkResult::num_operations() const { return _num_operations; }
+
 // === AbstractBenchmark ===============================================================================================
 // _____________________________________________________________________________________________________________________
 void AbstractBenchmark::reset() { _benchmark_result.clear(); }
@@ -84,6 +190,35 @@ void AbstractBenchmark::reset() { _benchmark_result.clear(); }
 // _____________________________________________________________________________________________________________________
 void AbstractBenchmark::set_verbosity(taskbench::VERBOSITY verbosity) { _verbosity = verbosity; }
 
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::set_measurement_config(const MeasurementConfig& config) { _measurement_config = config; }
+
+// _____________________________________________________________________________________________________________________
+const MeasurementConfig& AbstractBenchmark::measurement_config() const { return _measurement_config; }
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::set_num_threads(size_t num_threads) { _num_threads = std::max<size_t>(num_threads, 1); }
+
+// _____________________________________________________________________________________________________________________
+size_t AbstractBenchmark::num_threads() const { return _num_threads; }
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::set_scaling(bool enabled) { _scaling = enabled; }
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::set_placement(utils::Placement placement, int numa_node) {
+  // fail early instead of on the first multi threaded benchmark
+  static_cast<void>(utils::Topology::system().place(placement, 1, numa_node));
+  _placement = placement;
+  _numa_node = numa_node;
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::set_page_mode(utils::PageMode mode) { _page_mode = mode; }
+
+// _____________________________________________________________________________________________________________________
+utils::PageMode AbstractBenchmark::page_mode() const { return _page_mode; }
+
 // _____________________________________________________________________________________________________________________
 std::map<std::string, BenchmarkResult> AbstractBenchmark::results() { return _benchmark_result; }
 
@@ -93,6 +228,7 @@ const std::map<std::string, BenchmarkResult>& AbstractBenchmark::results() const
 // _____________________________________________________________________________________________________________________
 void AbstractBenchmark::_register_benchmark(uint64_t data_size, uint64_t num_operations, const std::string& name) {
   _benchmark_result.insert({name, BenchmarkResult(name, data_size, num_operations)});
+  utils::reset_peak_rss();
 }
 // _____________________________________________________________________________________________________________________
 void AbstractBenchmark::_add_result(const std::string& key, seconds value) {
@@ -102,6 +238,215 @@ void AbstractBenchmark::_add_result(const std::string& key, seconds value) {
   _benchmark_result.at(key).add_runtime(value);
 }
 
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_run_within_budget(const std::string& name, const std::function<void()>& run) {
+  try {
+    run();
+  } catch (const utils::BudgetExceeded& e) {
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::yellow), "\r    {:40} skipped: {}\n", name, e.what());
+      std::cout << std::flush;
+    }
+    BenchmarkResult result(name, 0, 0);
+    result.set_parameter("skipped", e.what());
+    _benchmark_result.insert_or_assign(name, std::move(result));
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_run_measurement(const std::string& name, seconds runtime,
+                                         const std::function<seconds(size_t)>& sample,
+                                         const std::function<void()>& on_sample) {
+  if (!_benchmark_result.contains(name)) {
+    throw std::runtime_error("Benchmark must be registered before it can be measured.");
+  }
+  _run_measurement(_benchmark_result.at(name), runtime, sample, on_sample);
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_run_measurement(BenchmarkResult& bm_res, seconds runtime,
+                                         const std::function<seconds(size_t)>& sample,
+                                         const std::function<void()>& on_sample) {
+  utils::Timer budget_timer;
+  budget_timer.start();
+
+  size_t batch_size = 1;
+  for (size_t i = 0; i < _measurement_config.warmup_iterations; ++i) {
+    batch_size = _calibrate_batch_size(batch_size, sample(batch_size));
+  }
+
+  // samples below the minimal sample time are dominated by timer overhead: they are discarded and retried with a
+  // larger batch until the budget is exhausted. The batch size is fixed before the first recorded sample, all samples
+  // of a result are taken with the same batch size.
+  auto sample_time = sample(batch_size);
+  while (budget_timer.count() < runtime) {
+    auto next_batch_size = _calibrate_batch_size(batch_size, sample_time);
+    if (next_batch_size == batch_size) {
+      break;
+    }
+    batch_size = next_batch_size;
+    sample_time = sample(batch_size);
+  }
+  bm_res.set_batch_size(batch_size);
+
+  while (true) {
+    bm_res.add_runtime(sample_time / static_cast<double>(batch_size));
+    if (on_sample) {
+      on_sample();
+    }
+    _print_runtime(bm_res);
+    if (_stop_measurement(bm_res, budget_timer.count(), runtime)) {
+      break;
+    }
+    sample_time = sample(batch_size);
+  }
+  bm_res.set_parameter("peak_rss", utils::peak_rss());
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_measure_parallel(const std::string& name, seconds runtime, size_t num_threads,
+                                          const ParallelJob& job, const std::function<void(size_t)>& prepare) {
+  if (!_benchmark_result.contains(name)) {
+    throw std::runtime_error("Benchmark must be registered before it can be measured.");
+  }
+  auto& bm_res = _benchmark_result.at(name);
+  bm_res.set_num_threads(num_threads);
+  // the workers are not pinned if the topology is unknown
+  auto cpus = _worker_pool(num_threads).cpus();
+  auto placement = cpus.empty() ? utils::Placement::NONE : _placement;
+  bm_res.set_parameter("placement", utils::to_string(placement));
+  if (placement == utils::Placement::NUMA_NODE) {
+    bm_res.set_parameter("numa_node", _numa_node);
+  }
+  bm_res.set_parameter("cpus", cpus);
+  static const auto limits = utils::detect_concurrency();
+  bm_res.set_parameter("concurrency", {{"hardware", limits.hardware},
+                                       {"affinity", limits.affinity},
+                                       {"cpuset", limits.cpuset},
+                                       {"cpu_quota", limits.cpu_quota},
+                                       {"effective", limits.effective}});
+  if (!_scaling) {
+    _measure_on_pool(bm_res, runtime, num_threads, job, prepare);
+    return;
+  }
+
+  std::vector<size_t> thread_counts;
+  for (size_t n = 1; n < num_threads; n *= 2) {
+    thread_counts.push_back(n);
+  }
+  thread_counts.push_back(num_threads);
+
+  for (auto n : thread_counts) {
+    if (n == num_threads) {
+      _measure_on_pool(bm_res, runtime, n, job, prepare);
+      bm_res.add_scaling_point(n, seconds(bm_res.runtime_mean()));
+    } else {
+      BenchmarkResult point_res(fmt::format("{} ({} threads)", name, n), bm_res.data_size(), bm_res.num_operations());
+      _measure_on_pool(point_res, runtime, n, job, prepare);
+      bm_res.add_scaling_point(n, seconds(point_res.runtime_mean()));
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_measure_parallel_sweep(const std::string& name, seconds runtime, size_t num_threads,
+                                                const std::string& parameter, const std::vector<uint64_t>& sizes,
+                                                const std::function<uint64_t(uint64_t)>& resize,
+                                                const ParallelJob& job, const std::function<void(size_t)>& prepare,
+                                                const std::function<nlohmann::json(uint64_t)>& annotate,
+                                                const std::function<uint64_t(uint64_t)>& operations,
+                                                const std::function<void(size_t)>& on_sample) {
+  if (!_benchmark_result.contains(name)) {
+    throw std::runtime_error("Benchmark must be registered before it can be measured.");
+  }
+  auto& bm_res = _benchmark_result.at(name);
+  seconds point_runtime = runtime / static_cast<double>(std::max<size_t>(sizes.size(), 1));
+  for (auto size : sizes) {
+    uint64_t data_size = resize(size);
+    uint64_t num_operations = bm_res.num_operations();
+    if (operations) {
+      num_operations = operations(size);
+    } else if (bm_res.data_size() > 0 && data_size != bm_res.data_size()) {
+      num_operations = static_cast<uint64_t>(static_cast<double>(num_operations) * static_cast<double>(data_size) /
+                                             static_cast<double>(bm_res.data_size()));
+    }
+    BenchmarkResult point_res(fmt::format("{} ({} {})", name, parameter, size), data_size, num_operations);
+    _measure_on_pool(point_res, point_runtime, num_threads, job, prepare, on_sample);
+    nlohmann::json parameters = {{parameter, size}};
+    if (annotate) {
+      parameters.update(annotate(size));
+    }
+    bm_res.add_sweep_point(std::move(parameters), data_size, num_operations, seconds(point_res.runtime_mean()));
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_measure_on_pool(BenchmarkResult& bm_res, seconds runtime, size_t num_threads,
+                                         const ParallelJob& job, const std::function<void(size_t)>& prepare,
+                                         const std::function<void(size_t)>& on_sample) {
+  auto& pool = _worker_pool(num_threads);
+  auto worker_job = [&](size_t thread_id) { job(thread_id, num_threads); };
+  _run_measurement(
+      bm_res, runtime,
+      [&](size_t batch_size) {
+        seconds time(0);
+        for (size_t i = 0; i < batch_size; ++i) {
+          if (prepare) {
+            prepare(num_threads);
+          }
+          time += pool.run(worker_job);
+        }
+        return time;
+      },
+      [&] {
+        bm_res.add_worker_timings(pool.timings());
+        if (on_sample) {
+          on_sample(bm_res.batch_size());
+        }
+      });
+}
+
+// _____________________________________________________________________________________________________________________
+utils::WorkerPool& AbstractBenchmark::_worker_pool(size_t num_threads) {
+  auto cpus = utils::Topology::system().place(_placement, num_threads, _numa_node);
+  if (!_pool || _pool->size() != num_threads || _pool->cpus() != cpus) {
+    _pool.reset();
+    _pool = std::make_unique<utils::WorkerPool>(num_threads, std::move(cpus));
+  }
+  return *_pool;
+}
+
+// _____________________________________________________________________________________________________________________
+size_t AbstractBenchmark::_calibrate_batch_size(size_t batch_size, seconds sample_time) const {
+  seconds min_sample_time = _measurement_config.min_sample_time;
+  if (sample_time >= min_sample_time) {
+    return batch_size;
+  }
+  if (sample_time.count() <= 0) {
+    return batch_size * 10;
+  }
+  // aim 20% above the minimal sample time but grow by at most two orders of magnitude per step
+  auto factor = std::min(100.0, 1.2 * min_sample_time / sample_time);
+  return std::max(batch_size + 1, static_cast<size_t>(static_cast<double>(batch_size) * factor));
+}
+
+// _____________________________________________________________________________________________________________________
+bool AbstractBenchmark::_stop_measurement(const BenchmarkResult& bm_res, seconds elapsed, seconds runtime) const {
+  const auto& runtimes = bm_res.runtimes();
+  if (runtimes.size() < _measurement_config.min_samples) {
+    return false;
+  }
+  if (_measurement_config.max_samples > 0 && runtimes.size() >= _measurement_config.max_samples) {
+    return true;
+  }
+  // the standard error of very few samples is itself too noisy to stop on, so the rule has its own floor
+  if (_measurement_config.target_rse > 0 && runtimes.size() >= std::max<size_t>(_measurement_config.min_samples, 5) &&
+      utils::rse(runtimes) <= _measurement_config.target_rse) {
+    return true;
+  }
+  return elapsed >= runtime;
+}
+
 // _____________________________________________________________________________________________________________________
 void AbstractBenchmark::_print_runtime(const taskbench::BenchmarkResult& bm_res) {
   if (_verbosity != VERBOSITY::OFF) {
@@ -128,4 +473,13 @@ void AbstractBenchmark::_print_o_per_second(const taskbench::BenchmarkResult& bm
   }
 }
 
+// _____________________________________________________________________________________________________________________
+void AbstractBenchmark::_print_latency(const taskbench::BenchmarkResult& bm_res) {
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::blue_violet), "[{:.2f} ns/op]",
+               bm_res.runtime_mean() / static_cast<double>(bm_res.num_operations()) * 1e9);
+    std::cout << std::flush;
+  }
+}
+
 }  // namespace taskbench
\ No newline at end of file
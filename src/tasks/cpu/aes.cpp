@@ -22,4 +22,18 @@ std::vector<unsigned char> decrypt(const std::vector<unsigned char>& data, const
   return aes.DecryptECB(data, key);
 }
 
+// _____________________________________________________________________________________________________________________
+std::unique_ptr<unsigned char[]> encrypt(const unsigned char* data, size_t size,
+                                         const std::vector<unsigned char>& key) {
+  AES aes(AESKeyLength::AES_256);
+  return std::unique_ptr<unsigned char[]>(aes.EncryptECB(data, size, key.data()));
+}
+
+// _____________________________________________________________________________________________________________________
+std::unique_ptr<unsigned char[]> decrypt(const unsigned char* data, size_t size,
+                                         const std::vector<unsigned char>& key) {
+  AES aes(AESKeyLength::AES_256);
+  return std::unique_ptr<unsigned char[]>(aes.DecryptECB(data, size, key.data()));
+}
+
 }  // namespace taskbench::cpu::aes
\ No newline at end of file
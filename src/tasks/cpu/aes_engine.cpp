@@ -0,0 +1,681 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/cpu/aes_engine.h>
+#include <taskbench/utils/cpu_features.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace taskbench::cpu::aes {
+
+static constexpr size_t block_bytes = 16;
+static constexpr size_t num_rounds = 14;
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(Implementation implementation) {
+  switch (implementation) {
+    case Implementation::PORTABLE:
+      return "portable";
+    case Implementation::AESNI:
+      return "aesni";
+    case Implementation::VAES:
+      return "vaes";
+  }
+  return "unknown";
+}
+
+// _____________________________________________________________________________________________________________________
+bool is_supported(Implementation implementation) {
+  const auto& features = utils::cpu_features();
+  switch (implementation) {
+    case Implementation::PORTABLE:
+      return true;
+    case Implementation::AESNI:
+      return features.aesni && features.pclmulqdq;
+    case Implementation::VAES:
+      return features.aesni && features.pclmulqdq && features.vaes && features.vpclmulqdq;
+  }
+  return false;
+}
+
+// _____________________________________________________________________________________________________________________
+std::vector<Implementation> implementations() {
+  std::vector<Implementation> res;
+  for (auto implementation : {Implementation::PORTABLE, Implementation::AESNI, Implementation::VAES}) {
+    if (is_supported(implementation)) {
+      res.push_back(implementation);
+    }
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(Mode mode) {
+  switch (mode) {
+    case Mode::CTR:
+      return "ctr";
+    case Mode::GCM:
+      return "gcm";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief Multiplication by x in GF(2^8)
+ */
+static constexpr uint8_t xtime(uint8_t a) { return static_cast<uint8_t>((a << 1) ^ ((a & 0x80) != 0 ? 0x1b : 0)); }
+
+static constexpr uint8_t rotl8(uint8_t a, unsigned shift) {
+  return static_cast<uint8_t>((a << shift) | (a >> (8 - shift)));
+}
+
+/**
+ * @brief AES S-box: affine transformation of the multiplicative inverse in GF(2^8)
+ */
+static constexpr std::array<uint8_t, 256> make_sbox() {
+  std::array<uint8_t, 256> sbox{};
+  // p runs through all non zero elements as powers of 3, q is the inverse of p
+  uint8_t p = 1;
+  uint8_t q = 1;
+  do {
+    p = static_cast<uint8_t>(p ^ xtime(p));
+    q = static_cast<uint8_t>(q ^ (q << 1));
+    q = static_cast<uint8_t>(q ^ (q << 2));
+    q = static_cast<uint8_t>(q ^ (q << 4));
+    if ((q & 0x80) != 0) {
+      q ^= 0x09;
+    }
+    sbox[p] = static_cast<uint8_t>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4) ^ 0x63);
+  } while (p != 1);
+  sbox[0] = 0x63;
+  return sbox;
+}
+
+static constexpr std::array<uint8_t, 256> sbox = make_sbox();
+
+static uint64_t load_be64(const unsigned char* data) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+static void store_be64(unsigned char* data, uint64_t value) {
+  for (size_t i = 0; i < 8; ++i) {
+    data[i] = static_cast<unsigned char>(value >> (56 - 8 * i));
+  }
+}
+
+/**
+ * @brief Word whose bytes in memory are counter in big endian order
+ */
+static uint32_t big_endian_word(uint32_t counter) {
+  unsigned char bytes[4] = {static_cast<unsigned char>(counter >> 24), static_cast<unsigned char>(counter >> 16),
+                            static_cast<unsigned char>(counter >> 8), static_cast<unsigned char>(counter)};
+  uint32_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+/**
+ * @brief AES-256 key expansion into 15 round keys
+ */
+static void expand_key(const unsigned char* key, unsigned char* round_keys) {
+  std::memcpy(round_keys, key, key_size);
+  uint8_t rcon = 1;
+  for (size_t i = key_size / 4; i < 4 * (num_rounds + 1); ++i) {
+    uint8_t t[4];
+    std::memcpy(t, round_keys + 4 * (i - 1), 4);
+    if (i % 8 == 0) {
+      uint8_t first = t[0];
+      t[0] = static_cast<uint8_t>(sbox[t[1]] ^ rcon);
+      t[1] = sbox[t[2]];
+      t[2] = sbox[t[3]];
+      t[3] = sbox[first];
+      rcon = xtime(rcon);
+    } else if (i % 8 == 4) {
+      for (auto& byte : t) {
+        byte = sbox[byte];
+      }
+    }
+    for (size_t j = 0; j < 4; ++j) {
+      round_keys[4 * i + j] = round_keys[4 * (i - 8) + j] ^ t[j];
+    }
+  }
+}
+
+/**
+ * @brief Keys used by the implementations
+ */
+struct Keys {
+  const unsigned char* round_keys;
+  const unsigned char* hash_key;
+  const unsigned char* hash_powers;
+};
+
+// ===== portable ======================================================================================================
+
+// _____________________________________________________________________________________________________________________
+static void portable_encrypt_block(const unsigned char* round_keys, const unsigned char* input,
+                                   unsigned char* output) {
+  uint8_t state[block_bytes];
+  for (size_t i = 0; i < block_bytes; ++i) {
+    state[i] = input[i] ^ round_keys[i];
+  }
+  for (size_t round = 1; round <= num_rounds; ++round) {
+    uint8_t t[block_bytes];
+    // SubBytes and ShiftRows: row r of column c (byte r + 4c) is taken from column c + r
+    for (size_t c = 0; c < 4; ++c) {
+      for (size_t r = 0; r < 4; ++r) {
+        t[r + 4 * c] = sbox[state[r + 4 * ((c + r) % 4)]];
+      }
+    }
+    if (round != num_rounds) {  // MixColumns
+      for (size_t c = 0; c < 4; ++c) {
+        uint8_t* a = t + 4 * c;
+        uint8_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+        auto all = static_cast<uint8_t>(a0 ^ a1 ^ a2 ^ a3);
+        a[0] = static_cast<uint8_t>(a0 ^ all ^ xtime(a0 ^ a1));
+        a[1] = static_cast<uint8_t>(a1 ^ all ^ xtime(a1 ^ a2));
+        a[2] = static_cast<uint8_t>(a2 ^ all ^ xtime(a2 ^ a3));
+        a[3] = static_cast<uint8_t>(a3 ^ all ^ xtime(a3 ^ a0));
+      }
+    }
+    for (size_t i = 0; i < block_bytes; ++i) {
+      state[i] = t[i] ^ round_keys[block_bytes * round + i];
+    }
+  }
+  std::memcpy(output, state, block_bytes);
+}
+
+/**
+ * @brief x = x * h in GF(2^128) (GCM bit order)
+ */
+static void portable_gf_multiply(unsigned char* x, const unsigned char* h) {
+  uint64_t x_hi = load_be64(x), x_lo = load_be64(x + 8);
+  uint64_t v_hi = load_be64(h), v_lo = load_be64(h + 8);
+  uint64_t z_hi = 0, z_lo = 0;
+  for (unsigned i = 0; i < 128; ++i) {
+    uint64_t bit = i < 64 ? (x_hi >> (63 - i)) & 1 : (x_lo >> (127 - i)) & 1;
+    uint64_t mask = 0 - bit;
+    z_hi ^= v_hi & mask;
+    z_lo ^= v_lo & mask;
+    uint64_t reduce = 0 - (v_lo & 1);
+    v_lo = (v_lo >> 1) | (v_hi << 63);
+    v_hi = (v_hi >> 1) ^ (reduce & 0xe100000000000000);
+  }
+  store_be64(x, z_hi);
+  store_be64(x + 8, z_lo);
+}
+
+// _____________________________________________________________________________________________________________________
+static void portable_ctr(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                         unsigned char* output, size_t size) {
+  unsigned char block[block_bytes];
+  unsigned char stream[block_bytes];
+  std::memcpy(block, nonce, nonce_size);
+  for (size_t i = 0; i < size; i += block_bytes, ++counter) {
+    uint32_t word = big_endian_word(counter);
+    std::memcpy(block + nonce_size, &word, sizeof(word));
+    portable_encrypt_block(keys.round_keys, block, stream);
+    size_t n = std::min(block_bytes, size - i);
+    for (size_t j = 0; j < n; ++j) {
+      output[i + j] = input[i + j] ^ stream[j];
+    }
+  }
+}
+
+/**
+ * @brief Hash size bytes of data (the last block zero padded) into state
+ */
+static void portable_ghash(const Keys& keys, unsigned char* state, const unsigned char* data, size_t size) {
+  for (size_t i = 0; i < size; i += block_bytes) {
+    size_t n = std::min(block_bytes, size - i);
+    for (size_t j = 0; j < n; ++j) {
+      state[j] ^= data[i + j];
+    }
+    portable_gf_multiply(state, keys.hash_key);
+  }
+}
+
+/**
+ * @brief CTR en-/decryption starting at counter and GHASH of the cipher text into state
+ */
+static void portable_gcm(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                         unsigned char* output, size_t size, bool encrypt, unsigned char* state) {
+  if (encrypt) {
+    portable_ctr(keys, nonce, counter, input, output, size);
+    portable_ghash(keys, state, output, size);
+  } else {
+    portable_ghash(keys, state, input, size);
+    portable_ctr(keys, nonce, counter, input, output, size);
+  }
+}
+
+#if defined(TASKBENCH_X86)
+// ===== AES-NI ========================================================================================================
+
+TASKBENCH_TARGET("aes,pclmul,ssse3") static inline __m128i byte_reflect(__m128i x) {
+  return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+TASKBENCH_TARGET("aes,pclmul,ssse3") static inline __m128i counter_block(const uint32_t* nonce, uint32_t counter) {
+  return _mm_set_epi32(static_cast<int>(big_endian_word(counter)), static_cast<int>(nonce[2]),
+                       static_cast<int>(nonce[1]), static_cast<int>(nonce[0]));
+}
+
+/**
+ * @brief Encrypt N blocks with their rounds interleaved
+ */
+template <size_t N>
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static inline void aesni_encrypt(const __m128i* round_keys, __m128i* blocks) {
+  for (size_t j = 0; j < N; ++j) {
+    blocks[j] = _mm_xor_si128(blocks[j], round_keys[0]);
+  }
+  for (size_t round = 1; round < num_rounds; ++round) {
+    for (size_t j = 0; j < N; ++j) {
+      blocks[j] = _mm_aesenc_si128(blocks[j], round_keys[round]);
+    }
+  }
+  for (size_t j = 0; j < N; ++j) {
+    blocks[j] = _mm_aesenclast_si128(blocks[j], round_keys[num_rounds]);
+  }
+}
+
+/**
+ * @brief Accumulate the 256 bit carry-less product of a and b as low, middle (not yet shifted) and high part
+ */
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static inline void clmul_accumulate(__m128i a, __m128i b, __m128i& lo, __m128i& mid, __m128i& hi) {
+  lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));
+  mid = _mm_xor_si128(mid, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01)));
+  hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));
+}
+
+/**
+ * @brief Reduce a (sum of) carry-less products of byte reflected operands modulo the GCM polynomial (Intel carry-less
+ *  multiplication white paper, algorithm 5). Summing products before a single reduction is valid since the reduction
+ *  is linear.
+ */
+TASKBENCH_TARGET("aes,pclmul,ssse3") static inline __m128i ghash_reduce(__m128i lo, __m128i mid, __m128i hi) {
+  lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+  hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+  // shift the 256 bit product left by one bit (bit reflection)
+  __m128i lo_carry = _mm_srli_epi32(lo, 31);
+  __m128i hi_carry = _mm_srli_epi32(hi, 31);
+  lo = _mm_slli_epi32(lo, 1);
+  hi = _mm_slli_epi32(hi, 1);
+  __m128i cross = _mm_srli_si128(lo_carry, 12);
+  hi_carry = _mm_slli_si128(hi_carry, 4);
+  lo_carry = _mm_slli_si128(lo_carry, 4);
+  lo = _mm_or_si128(lo, lo_carry);
+  hi = _mm_or_si128(_mm_or_si128(hi, hi_carry), cross);
+  // reduction
+  __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+  __m128i b = _mm_srli_si128(a, 4);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(a, 12));
+  __m128i c = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+  lo = _mm_xor_si128(lo, _mm_xor_si128(c, b));
+  return _mm_xor_si128(hi, lo);
+}
+
+/**
+ * @brief Hash n <= Engine::num_hash_powers byte reflected blocks into the byte reflected state y with one reduction:
+ *  (y + x[0]) * H^n + x[1] * H^(n-1) + ... + x[n-1] * H
+ */
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static inline __m128i aesni_ghash_blocks(__m128i y, const __m128i* x, size_t n, const __m128i* powers) {
+  __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+  clmul_accumulate(_mm_xor_si128(y, x[0]), powers[Engine::num_hash_powers - n], lo, mid, hi);
+  for (size_t i = 1; i < n; ++i) {
+    clmul_accumulate(x[i], powers[Engine::num_hash_powers - n + i], lo, mid, hi);
+  }
+  return ghash_reduce(lo, mid, hi);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static void aesni_ctr(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                      unsigned char* output, size_t size) {
+  __m128i round_keys[num_rounds + 1];
+  for (size_t round = 0; round <= num_rounds; ++round) {
+    round_keys[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.round_keys + block_bytes * round));
+  }
+  uint32_t nonce_words[3];
+  std::memcpy(nonce_words, nonce, nonce_size);
+
+  size_t i = 0;
+  for (; i + 8 * block_bytes <= size; i += 8 * block_bytes, counter += 8) {
+    __m128i blocks[8];
+    for (size_t j = 0; j < 8; ++j) {
+      blocks[j] = counter_block(nonce_words, counter + static_cast<uint32_t>(j));
+    }
+    aesni_encrypt<8>(round_keys, blocks);
+    for (size_t j = 0; j < 8; ++j) {
+      auto* in = reinterpret_cast<const __m128i*>(input + i) + j;
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i) + j, _mm_xor_si128(_mm_loadu_si128(in), blocks[j]));
+    }
+  }
+  for (; i < size; i += block_bytes, ++counter) {
+    __m128i block = counter_block(nonce_words, counter);
+    aesni_encrypt<1>(round_keys, &block);
+    size_t n = std::min(block_bytes, size - i);
+    if (n == block_bytes) {
+      auto* in = reinterpret_cast<const __m128i*>(input + i);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_xor_si128(_mm_loadu_si128(in), block));
+    } else {
+      unsigned char stream[block_bytes];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(stream), block);
+      for (size_t j = 0; j < n; ++j) {
+        output[i + j] = input[i + j] ^ stream[j];
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static void aesni_ghash(const Keys& keys, unsigned char* state, const unsigned char* data, size_t size) {
+  const auto* powers = reinterpret_cast<const __m128i*>(keys.hash_powers);
+  __m128i y = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)));
+  size_t i = 0;
+  for (; i + 8 * block_bytes <= size; i += 8 * block_bytes) {
+    __m128i x[8];
+    for (size_t j = 0; j < 8; ++j) {
+      x[j] = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i) + j));
+    }
+    y = aesni_ghash_blocks(y, x, 8, powers);
+  }
+  for (; i < size; i += block_bytes) {
+    unsigned char block[block_bytes] = {};
+    std::memcpy(block, data + i, std::min(block_bytes, size - i));
+    __m128i x = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)));
+    y = aesni_ghash_blocks(y, &x, 1, powers);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), byte_reflect(y));
+}
+
+/**
+ * @brief CTR en-/decryption and GHASH of 8 blocks per iteration: the AES rounds and the carry-less multiplications of
+ *  an iteration are independent and overlap in the pipeline
+ */
+TASKBENCH_TARGET("aes,pclmul,ssse3")
+static void aesni_gcm(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                      unsigned char* output, size_t size, bool encrypt, unsigned char* state) {
+  __m128i round_keys[num_rounds + 1];
+  for (size_t round = 0; round <= num_rounds; ++round) {
+    round_keys[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.round_keys + block_bytes * round));
+  }
+  const auto* powers = reinterpret_cast<const __m128i*>(keys.hash_powers);
+  uint32_t nonce_words[3];
+  std::memcpy(nonce_words, nonce, nonce_size);
+  __m128i y = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)));
+
+  size_t i = 0;
+  for (; i + 8 * block_bytes <= size; i += 8 * block_bytes, counter += 8) {
+    __m128i in[8], blocks[8], x[8];
+    for (size_t j = 0; j < 8; ++j) {
+      in[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i) + j);
+      blocks[j] = counter_block(nonce_words, counter + static_cast<uint32_t>(j));
+    }
+    aesni_encrypt<8>(round_keys, blocks);
+    for (size_t j = 0; j < 8; ++j) {
+      __m128i out = _mm_xor_si128(in[j], blocks[j]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i) + j, out);
+      x[j] = byte_reflect(encrypt ? out : in[j]);
+    }
+    y = aesni_ghash_blocks(y, x, 8, powers);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), byte_reflect(y));
+
+  if (encrypt) {
+    aesni_ctr(keys, nonce, counter, input + i, output + i, size - i);
+    aesni_ghash(keys, state, output + i, size - i);
+  } else {
+    aesni_ghash(keys, state, input + i, size - i);
+    aesni_ctr(keys, nonce, counter, input + i, output + i, size - i);
+  }
+}
+
+// ===== VAES ==========================================================================================================
+
+/**
+ * @brief Counter blocks of two 128 bit lanes: the nonce and the byte swapped little endian counters of dword 3
+ */
+struct VaesCounters {
+  TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")
+  VaesCounters(const unsigned char* nonce, uint32_t counter) {
+    uint32_t words[3];
+    std::memcpy(words, nonce, nonce_size);
+    base = _mm256_broadcastsi128_si256(
+        _mm_set_epi32(0, static_cast<int>(words[2]), static_cast<int>(words[1]), static_cast<int>(words[0])));
+    counters = _mm256_set_epi32(static_cast<int>(counter + 1), 0, 0, 0, static_cast<int>(counter), 0, 0, 0);
+  }
+
+  TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3") __m256i next() {
+    const __m256i swap = _mm256_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 15,
+                                          14, 13, 12, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                                          -128, 15, 14, 13, 12);
+    const __m256i two = _mm256_set_epi32(2, 0, 0, 0, 2, 0, 0, 0);
+    __m256i blocks = _mm256_or_si256(base, _mm256_shuffle_epi8(counters, swap));
+    counters = _mm256_add_epi32(counters, two);
+    return blocks;
+  }
+
+  __m256i base;
+  __m256i counters;
+};
+
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3") static inline __m256i byte_reflect_256(__m256i x) {
+  const __m256i reflect = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                                           10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_shuffle_epi8(x, reflect);
+}
+
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3") static inline __m128i fold_lanes(__m256i x) {
+  return _mm_xor_si128(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+}
+
+/**
+ * @brief Encrypt 16 blocks (8 vectors) with their rounds interleaved
+ */
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")
+static inline void vaes_encrypt(const __m256i* round_keys, __m256i* blocks) {
+  for (size_t j = 0; j < 8; ++j) {
+    blocks[j] = _mm256_xor_si256(blocks[j], round_keys[0]);
+  }
+  for (size_t round = 1; round < num_rounds; ++round) {
+    for (size_t j = 0; j < 8; ++j) {
+      blocks[j] = _mm256_aesenc_epi128(blocks[j], round_keys[round]);
+    }
+  }
+  for (size_t j = 0; j < 8; ++j) {
+    blocks[j] = _mm256_aesenclast_epi128(blocks[j], round_keys[num_rounds]);
+  }
+}
+
+/**
+ * @brief Hash 16 byte reflected blocks (8 vectors) into the byte reflected state y with one reduction
+ */
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")
+static inline __m128i vaes_ghash_blocks(__m128i y, const __m256i* x, const __m256i* powers) {
+  __m256i lo = _mm256_setzero_si256(), mid = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+  for (size_t j = 0; j < 8; ++j) {
+    __m256i a = j == 0 ? _mm256_xor_si256(x[0], _mm256_inserti128_si256(_mm256_setzero_si256(), y, 0)) : x[j];
+    lo = _mm256_xor_si256(lo, _mm256_clmulepi64_epi128(a, powers[j], 0x00));
+    mid = _mm256_xor_si256(mid, _mm256_xor_si256(_mm256_clmulepi64_epi128(a, powers[j], 0x10),
+                                                 _mm256_clmulepi64_epi128(a, powers[j], 0x01)));
+    hi = _mm256_xor_si256(hi, _mm256_clmulepi64_epi128(a, powers[j], 0x11));
+  }
+  return ghash_reduce(fold_lanes(lo), fold_lanes(mid), fold_lanes(hi));
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")
+static void vaes_ctr(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                     unsigned char* output, size_t size) {
+  __m256i round_keys[num_rounds + 1];
+  for (size_t round = 0; round <= num_rounds; ++round) {
+    round_keys[round] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.round_keys + block_bytes * round)));
+  }
+  VaesCounters counters(nonce, counter);
+
+  size_t i = 0;
+  for (; i + 16 * block_bytes <= size; i += 16 * block_bytes, counter += 16) {
+    __m256i blocks[8];
+    for (auto& block : blocks) {
+      block = counters.next();
+    }
+    vaes_encrypt(round_keys, blocks);
+    for (size_t j = 0; j < 8; ++j) {
+      auto* in = reinterpret_cast<const __m256i*>(input + i) + j;
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i) + j,
+                          _mm256_xor_si256(_mm256_loadu_si256(in), blocks[j]));
+    }
+  }
+  aesni_ctr(keys, nonce, counter, input + i, output + i, size - i);
+}
+
+/**
+ * @brief CTR en-/decryption and GHASH of 16 blocks per iteration
+ */
+TASKBENCH_TARGET("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")
+static void vaes_gcm(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+                     unsigned char* output, size_t size, bool encrypt, unsigned char* state) {
+  __m256i round_keys[num_rounds + 1];
+  for (size_t round = 0; round <= num_rounds; ++round) {
+    round_keys[round] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.round_keys + block_bytes * round)));
+  }
+  const auto* powers = reinterpret_cast<const __m256i*>(keys.hash_powers);
+  VaesCounters counters(nonce, counter);
+  __m128i y = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)));
+
+  size_t i = 0;
+  for (; i + 16 * block_bytes <= size; i += 16 * block_bytes, counter += 16) {
+    __m256i in[8], blocks[8], x[8];
+    for (size_t j = 0; j < 8; ++j) {
+      in[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i) + j);
+      blocks[j] = counters.next();
+    }
+    vaes_encrypt(round_keys, blocks);
+    for (size_t j = 0; j < 8; ++j) {
+      __m256i out = _mm256_xor_si256(in[j], blocks[j]);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i) + j, out);
+      x[j] = byte_reflect_256(encrypt ? out : in[j]);
+    }
+    y = vaes_ghash_blocks(y, x, powers);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), byte_reflect(y));
+  aesni_gcm(keys, nonce, counter, input + i, output + i, size - i, encrypt, state);
+}
+#endif
+
+/**
+ * @brief Functions of an implementation
+ */
+struct Kernels {
+  void (*ctr)(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+              unsigned char* output, size_t size);
+  void (*ghash)(const Keys& keys, unsigned char* state, const unsigned char* data, size_t size);
+  void (*gcm)(const Keys& keys, const unsigned char* nonce, uint32_t counter, const unsigned char* input,
+              unsigned char* output, size_t size, bool encrypt, unsigned char* state);
+};
+
+// _____________________________________________________________________________________________________________________
+static Kernels kernels(Implementation implementation) {
+  switch (implementation) {
+#if defined(TASKBENCH_X86)
+    case Implementation::AESNI:
+      return {aesni_ctr, aesni_ghash, aesni_gcm};
+    case Implementation::VAES:
+      // short inputs (e.g. the additional authenticated data) are hashed on 128 bit registers
+      return {vaes_ctr, aesni_ghash, vaes_gcm};
+#endif
+    default:
+      return {portable_ctr, portable_ghash, portable_gcm};
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+Engine::Engine(const unsigned char* key, Implementation implementation) : _implementation(implementation) {
+  if (!is_supported(implementation)) {
+    throw std::runtime_error("AES implementation '" + to_string(implementation) + "' is not available.");
+  }
+  expand_key(key, _round_keys.data());
+  unsigned char zero[block_bytes] = {};
+  portable_encrypt_block(_round_keys.data(), zero, _hash_key.data());
+
+  // H^k (GCM order) byte reflected at position num_hash_powers - k
+  unsigned char power[block_bytes];
+  std::memcpy(power, _hash_key.data(), block_bytes);
+  for (size_t k = 1; k <= num_hash_powers; ++k) {
+    if (k > 1) {
+      portable_gf_multiply(power, _hash_key.data());
+    }
+    std::reverse_copy(power, power + block_bytes, _hash_powers.data() + block_bytes * (num_hash_powers - k));
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+Engine::Engine(const unsigned char* key) : Engine(key, implementations().back()) {}
+
+// _____________________________________________________________________________________________________________________
+Implementation Engine::implementation() const { return _implementation; }
+
+// _____________________________________________________________________________________________________________________
+void Engine::ctr(const unsigned char* nonce, uint32_t counter, const unsigned char* input, unsigned char* output,
+                 size_t size) const {
+  kernels(_implementation).ctr({_round_keys.data(), _hash_key.data(), _hash_powers.data()}, nonce, counter, input,
+                               output, size);
+}
+
+// _____________________________________________________________________________________________________________________
+void Engine::gcm_encrypt(const unsigned char* nonce, const unsigned char* aad, size_t aad_size,
+                         const unsigned char* input, unsigned char* output, size_t size, unsigned char* tag) const {
+  _gcm(nonce, aad, aad_size, input, output, size, true, tag);
+}
+
+// _____________________________________________________________________________________________________________________
+bool Engine::gcm_decrypt(const unsigned char* nonce, const unsigned char* aad, size_t aad_size,
+                         const unsigned char* input, unsigned char* output, size_t size,
+                         const unsigned char* tag) const {
+  unsigned char expected[tag_size];
+  _gcm(nonce, aad, aad_size, input, output, size, false, expected);
+  unsigned char diff = 0;
+  for (size_t i = 0; i < tag_size; ++i) {
+    diff |= expected[i] ^ tag[i];
+  }
+  return diff == 0;
+}
+
+// _____________________________________________________________________________________________________________________
+void Engine::_gcm(const unsigned char* nonce, const unsigned char* aad, size_t aad_size, const unsigned char* input,
+                  unsigned char* output, size_t size, bool encrypt, unsigned char* tag) const {
+  auto functions = kernels(_implementation);
+  Keys keys{_round_keys.data(), _hash_key.data(), _hash_powers.data()};
+  unsigned char state[block_bytes] = {};
+  functions.ghash(keys, state, aad, aad_size);
+  // counter 1 encrypts the tag, the data starts at counter 2
+  functions.gcm(keys, nonce, 2, input, output, size, encrypt, state);
+  unsigned char lengths[block_bytes];
+  store_be64(lengths, static_cast<uint64_t>(aad_size) * 8);
+  store_be64(lengths + 8, static_cast<uint64_t>(size) * 8);
+  functions.ghash(keys, state, lengths, block_bytes);
+  functions.ctr(keys, nonce, 1, state, tag, tag_size);
+}
+
+}  // namespace taskbench::cpu::aes
\ No newline at end of file
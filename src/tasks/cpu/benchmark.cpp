@@ -7,50 +7,79 @@
 
 #include <fmt/color.h>
 #include <taskbench/tasks/cpu/benchmark.h>
+#include <taskbench/utils/cpu_features.h>
 #include <taskbench/utils/data_generator.h>
+#include <taskbench/utils/mapped_file.h>
 #include <taskbench/utils/statistics.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace taskbench::cpu {
 
-struct thread_compression_data {
-  std::thread thread;
-  std::vector<char> plain_data;
-  std::vector<char> compressed_data;
-};
-
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_all(seconds run_time) {
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::beige) | fmt::emphasis::bold, "CPU Benchmarks:\n");
     std::cout << std::flush;
   }
-  run_aes(run_time);
-  run_compression(run_time);
-  run_fft(run_time);
-  run_mmul(run_time);
-  run_sort(run_time);
-  run_synthetic(run_time);
+  _run_within_budget("CPU AES", [&] { run_aes(run_time); });
+  _run_within_budget("CPU Compression", [&] { run_compression(run_time); });
+  _run_within_budget("CPU FFT", [&] { run_fft(run_time); });
+  _run_within_budget("CPU Matrix Multiplication", [&] { run_mmul(run_time); });
+  _run_within_budget("CPU Sort", [&] { run_sort(run_time); });
+  _run_within_budget("CPU Synthetic", [&] { run_synthetic(run_time); });
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_distributions(std::vector<utils::Distribution> distributions) {
+  _distributions = std::move(distributions);
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_record_payloads(std::vector<size_t> payloads) {
+  for (auto payload : payloads) {
+    if (std::find(sort::record_payloads.begin(), sort::record_payloads.end(), payload) == sort::record_payloads.end()) {
+      throw std::runtime_error("Unsupported record payload size: " + std::to_string(payload));
+    }
+  }
+  _record_payloads = std::move(payloads);
 }
 
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_input_file(std::string path) { _input_file = std::move(path); }
+
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_aes(seconds runtime) {
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  AES Benchmarks:\n");
     std::cout << std::flush;
   }
-  utils::Timer timer;
+  auto key = utils::DataGenerator::vector<unsigned char>(255, 16, 48, 122);
+
+  if (!_input_file.empty()) {
+    _run_aes_file(runtime, key);
+    return;
+  }
 
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::slate_gray) | fmt::emphasis::italic, "    Building benchmark data...");
     std::cout << std::flush;
   }
-  auto plain_data = utils::DataGenerator::vector<unsigned char>(S_16_MiB, 42, 48, 122);
-  auto key = utils::DataGenerator::vector<unsigned char>(255, 16, 48, 122);
-  std::vector<unsigned char> encrypted_data;
-  encrypted_data.reserve(plain_data.size());
+  auto plain_data = _allocate<unsigned char>(S_16_MiB);
+  utils::DataGenerator::fill<unsigned char>(plain_data.data(), plain_data.size(), 42, 48, 122);
+  // the ECB library allocates its output, the results are kept until the next run replaces them
+  std::unique_ptr<unsigned char[]> encrypted_data;
+  std::unique_ptr<unsigned char[]> decrypted_data;
 
   {  // encryption
     std::string name("AES Encryption");
@@ -61,17 +90,8 @@ void Benchmark::run_aes(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      encrypted_data = aes::encrypt(plain_data, key);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure(name, runtime, [&] { encrypted_data = aes::encrypt(plain_data.data(), plain_data.size(), key); });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(plain_data.page_mode()));
   }
 
   {  // decryption
@@ -82,165 +102,408 @@ void Benchmark::run_aes(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      plain_data = aes::decrypt(encrypted_data, key);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+    _measure(name, runtime, [&] { decrypted_data = aes::decrypt(encrypted_data.get(), plain_data.size(), key); });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(plain_data.page_mode()));
+  }
+  if (_verbosity != VERBOSITY::OFF) {
+    std::cout << std::endl;
+  }
+
+  _run_aes_engines(runtime, plain_data.data(), plain_data.size(), key,
+                   {{"page_mode", to_string(plain_data.page_mode())}}, "");
+
+  // the 16 MiB input is split into small segments on many cores: the multi threaded benchmark uses a larger buffer
+  plain_data = utils::Buffer<unsigned char>();
+  encrypted_data.reset();
+  decrypted_data.reset();
+  auto parallel_data = _allocate<unsigned char>(S_256_MiB);
+  utils::DataGenerator::fill<unsigned char>(parallel_data.data(), parallel_data.size(), 42, 48, 122);
+  _run_aes_parallel(runtime, parallel_data.data(), parallel_data.size(), key,
+                    {{"page_mode", to_string(parallel_data.page_mode())}}, "");
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::_run_aes_file(seconds runtime, const std::vector<unsigned char>& key) {
+  utils::MappedFile file(_input_file);
+  file.prefault();
+  const auto* data = reinterpret_cast<const unsigned char*>(file.data());
+  // whole blocks are encrypted in place, the remaining bytes are zero padded to a block
+  size_t blocks_size = file.size() / aes::block_size * aes::block_size;
+  std::array<unsigned char, aes::block_size> tail{};
+  std::copy(data + blocks_size, data + file.size(), tail.begin());
+  bool has_tail = blocks_size != file.size();
+
+  std::unique_ptr<unsigned char[]> encrypted;
+  std::unique_ptr<unsigned char[]> encrypted_tail;
+
+  {  // encryption
+    std::string name("AES Encryption (file)");
+    _register_benchmark(file.size(), 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    _measure(name, runtime, [&] {
+      encrypted = aes::encrypt(data, blocks_size, key);
+      if (has_tail) {
+        encrypted_tail = aes::encrypt(tail.data(), tail.size(), key);
+      }
+    });
+    _benchmark_result.at(name).set_parameter("input", file.path());
+  }
+
+  {  // decryption
+    std::string name("AES Decryption (file)");
+    _register_benchmark(file.size(), 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40} ", name);
+      std::cout << std::flush;
     }
+
+    std::unique_ptr<unsigned char[]> decrypted;
+    std::unique_ptr<unsigned char[]> decrypted_tail;
+    _measure(name, runtime, [&] {
+      decrypted = aes::decrypt(encrypted.get(), blocks_size, key);
+      if (has_tail) {
+        decrypted_tail = aes::decrypt(encrypted_tail.get(), tail.size(), key);
+      }
+    });
+    _benchmark_result.at(name).set_parameter("input", file.path());
   }
   if (_verbosity != VERBOSITY::OFF) {
     std::cout << std::endl;
   }
+
+  _run_aes_engines(runtime, data, file.size(), key, {{"input", file.path()}}, ", file");
+  _run_aes_parallel(runtime, data, file.size(), key, {{"input", file.path()}}, ", file");
 }
 
 // _____________________________________________________________________________________________________________________
-void Benchmark::run_compression(seconds runtime) {
-  utils::Timer timer;
+void Benchmark::_run_aes_engines(seconds runtime, const unsigned char* data, size_t size,
+                                 const std::vector<unsigned char>& key, const nlohmann::json& parameters,
+                                 const std::string& suffix) {
+  // the engines encrypt into caller provided buffers: the buffers are allocated once for all implementations
+  auto encrypted = _allocate<unsigned char>(size);
+  auto decrypted = _allocate<unsigned char>(size);
+  const std::array<unsigned char, aes::nonce_size> nonce{};
+  const std::array<unsigned char, 16> aad{};
+  std::array<unsigned char, aes::tag_size> tag{};
+
+  for (auto implementation : aes::implementations()) {
+    // the key schedule is expanded once per engine, not per measurement
+    aes::Engine engine(key.data(), implementation);
+    auto run = [&](aes::Mode mode, const std::string& operation, const std::function<void()>& fn) {
+      auto name = fmt::format("AES {} ({}{})", operation, aes::to_string(implementation), suffix);
+      _register_benchmark(size, 0, name);
+      if (_verbosity != VERBOSITY::OFF) {
+        fmt::print(fg(fmt::color::azure), "    {:40}", name);
+        std::cout << std::flush;
+      }
+      _measure(name, runtime, fn);
+      _benchmark_result.at(name).set_parameter("implementation", aes::to_string(implementation));
+      _benchmark_result.at(name).set_parameter("mode", aes::to_string(mode));
+      for (const auto& [parameter, value] : parameters.items()) {
+        _benchmark_result.at(name).set_parameter(parameter, value);
+      }
+      _print_gib_per_second(_benchmark_result.at(name));
+      if (_verbosity != VERBOSITY::OFF) {
+        std::cout << std::endl;
+      }
+    };
+
+    run(aes::Mode::CTR, "CTR Encryption", [&] { engine.ctr(nonce.data(), 1, data, encrypted.data(), size); });
+    run(aes::Mode::GCM, "GCM Encryption", [&] {
+      engine.gcm_encrypt(nonce.data(), aad.data(), aad.size(), data, encrypted.data(), size, tag.data());
+    });
+    run(aes::Mode::GCM, "GCM Decryption", [&] {
+      if (!engine.gcm_decrypt(nonce.data(), aad.data(), aad.size(), encrypted.data(), decrypted.data(), size,
+                              tag.data())) {
+        throw std::runtime_error("AES GCM authentication failed.");
+      }
+    });
+  }
+}
 
+// _____________________________________________________________________________________________________________________
+void Benchmark::_run_aes_parallel(seconds runtime, const unsigned char* data, size_t size,
+                                  const std::vector<unsigned char>& key, const nlohmann::json& parameters,
+                                  const std::string& suffix) {
+  auto encrypted = _allocate<unsigned char>(size);
+  aes::Engine engine(key.data());
+  const std::array<unsigned char, aes::nonce_size> nonce{};
+  const size_t num_blocks = (size + aes::block_size - 1) / aes::block_size;
+
+  std::string name("AES CTR Encryption (multi threaded" + suffix + ")");
+  _register_benchmark(size, 0, name);
   if (_verbosity != VERBOSITY::OFF) {
-    fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  ZStandard Benchmarks:\n");
+    fmt::print(fg(fmt::color::azure), "    {:40}", name);
     std::cout << std::flush;
   }
 
+  {
+    // the thread count sweep is the purpose of this benchmark: it is measured even if scaling is disabled. The setting
+    // is restored when the scope is left, also if the measurement throws.
+    struct ScalingGuard {
+      bool& scaling;
+      bool previous;
+      ~ScalingGuard() { scaling = previous; }
+    } scaling_guard{_scaling, std::exchange(_scaling, true)};
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      // segments of whole blocks: the counter of a segment follows from its offset, the threads share no state
+      auto [begin, end] = utils::partition(num_blocks, thread_id, num_threads);
+      size_t first = begin * aes::block_size;
+      size_t last = std::min(end * aes::block_size, size);
+      engine.ctr(nonce.data(), static_cast<uint32_t>(1 + begin), data + first, encrypted.data() + first, last - first);
+    });
+  }
+
+  auto& result = _benchmark_result.at(name);
+  result.set_parameter("implementation", aes::to_string(engine.implementation()));
+  result.set_parameter("mode", aes::to_string(aes::Mode::CTR));
+  for (const auto& [parameter, value] : parameters.items()) {
+    result.set_parameter(parameter, value);
+  }
+  _print_gib_per_second(result);
+
+  if (double frequency = utils::tsc_frequency(); frequency > 0) {
+    // reference cycles of all threads per byte based on the mean runtime
+    auto cycles_per_byte = [&](size_t num_threads, double runtime_mean) {
+      return runtime_mean * frequency * static_cast<double>(num_threads) / static_cast<double>(size);
+    };
+    nlohmann::json scaling_cycles = nlohmann::json::array();
+    for (const auto& point : result.scaling()) {
+      scaling_cycles.push_back(
+          {{"threads", point.num_threads}, {"cycles_per_byte", cycles_per_byte(point.num_threads, point.runtime)}});
+    }
+    double total_cycles = cycles_per_byte(result.num_threads(), result.runtime_mean());
+    result.set_parameter("tsc_frequency", frequency);
+    result.set_parameter("cycles_per_byte", total_cycles);
+    result.set_parameter("scaling_cycles_per_byte", std::move(scaling_cycles));
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::blue_violet), " [{:.2f} cycles/B]", total_cycles);
+      std::cout << std::flush;
+    }
+  }
   if (_verbosity != VERBOSITY::OFF) {
-    fmt::print(fg(fmt::color::slate_gray) | fmt::emphasis::italic, "    Building benchmark data...");
+    std::cout << std::endl;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_compression(seconds runtime) {
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  ZStandard Benchmarks:\n");
     std::cout << std::flush;
   }
 
-  auto plain_data = utils::DataGenerator::vector<char>(S_256_MiB, 42, 48, 122);
-  std::vector<char> compressed_data(plain_data.size());
+  if (!_input_file.empty()) {  // user supplied corpus: compressed in place, decompressed into a buffer of its size
+    utils::MappedFile file(_input_file);
+    file.prefault();
+    auto output = _allocate<char>(file.size());
+    _run_compression(runtime, {file.data(), file.size()}, {output.data(), file.size()}, {{"input", file.path()}},
+                     ", file");
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+    return;
+  }
+
+  auto plain_data = _allocate<char>(S_256_MiB);
+
+  // inputs: uniform printable characters, Zipf distributed characters and text
+  std::vector<std::pair<std::string, std::function<void()>>> inputs{
+      {"uniform", [&] { utils::DataGenerator::fill<char>(plain_data.data(), plain_data.size(), 42, 48, 122); }},
+      {"zipf",
+       [&] {
+         utils::DataGenerator::fill<char>(plain_data.data(), plain_data.size(), 42, utils::Distribution::ZIPF, 48, 122);
+       }},
+      {"text", [&] { utils::DataGenerator::text(plain_data.data(), plain_data.size(), 42); }}};
+
+  for (const auto& [distribution, generate] : inputs) {
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::slate_gray) | fmt::emphasis::italic, "\r    Building benchmark data...");
+      std::cout << std::flush;
+    }
+    generate();
+    // uniform inputs keep the plain names
+    std::string suffix = distribution == "uniform" ? "" : ", " + distribution;
+    _run_compression(runtime, {plain_data.data(), plain_data.size()}, {plain_data.data(), plain_data.size()},
+                     {{"distribution", distribution}, {"page_mode", to_string(plain_data.page_mode())}}, suffix);
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::_run_compression(seconds runtime, std::span<const char> input, std::span<char> output,
+                                 const nlohmann::json& parameters, const std::string& suffix) {
+  auto set_parameters = [&](const std::string& name, const std::string& strategy, size_t compressed_size) {
+    auto& result = _benchmark_result.at(name);
+    result.set_parameter("level", compression::default_level);
+    result.set_parameter("strategy", strategy);
+    if (compressed_size > 0) {
+      result.set_parameter("ratio", static_cast<double>(input.size()) / static_cast<double>(compressed_size));
+    }
+    for (const auto& [key, value] : parameters.items()) {
+      result.set_parameter(key, value);
+    }
+  };
+
+  auto compressed_data = _allocate<char>(compression::compress_bound(input.size()));
+  size_t compressed_size = 0;
+  // the contexts are created once and reused by every measured operation
+  compression::Engine engine;
 
   {  // compression
-    std::string name("Compression (ZStandard, 1 thread)");
-    _register_benchmark(plain_data.size(), 0, name);
+    std::string name("Compression (ZStandard, 1 thread" + suffix + ")");
+    _register_benchmark(input.size(), 0, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print("\r                                              ");
       fmt::print(fg(fmt::color::azure), "\r    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      compression::compress(plain_data, compressed_data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      compressed_data.resize(plain_data.size());
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure(name, runtime, [&] {
+      compressed_size = engine.compress(input.data(), input.size(), compressed_data.data(), compressed_data.size());
+    });
+    set_parameters(name, "single_frame", compressed_size);
   }
 
   {  // decompression
-    std::string name("Decompression (ZStandard, 1 thread)");
-    _register_benchmark(compressed_data.size(), 0, name);
+    std::string name("Decompression (ZStandard, 1 thread" + suffix + ")");
+    _register_benchmark(input.size(), 0, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      compression::decompress(compressed_data, plain_data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure(name, runtime, [&] {
+      engine.decompress(compressed_data.data(), compressed_size, output.data(), output.size());
+    });
+    set_parameters(name, "single_frame", compressed_size);
   }
 
-  std::vector<thread_compression_data> threads(std::thread::hardware_concurrency());
-  auto per_thread_size = static_cast<ssize_t>(plain_data.size() / threads.size());
-  // add thread specific data
-  ssize_t offset = 0;
-  for (auto& thread : threads) {
-    thread.plain_data.assign(plain_data.begin() + offset, plain_data.begin() + offset + per_thread_size);
-    thread.compressed_data = std::vector<char>(per_thread_size);
-    offset += per_thread_size;
+  if (compression::supports_workers()) {  // compression multi thread: a single frame compressed by ZStandard's workers
+    std::string name("Compression (ZStandard, zstd workers" + suffix + ")");
+    _register_benchmark(input.size(), 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    // ZStandard spawns and places its worker threads itself: measured from the calling thread
+    compression::Engine workers_engine(compression::default_level, static_cast<int>(_num_threads));
+    size_t frame_size = 0;
+    _measure(name, runtime, [&] {
+      frame_size =
+          workers_engine.compress(input.data(), input.size(), compressed_data.data(), compressed_data.size());
+    });
+    set_parameters(name, "zstd_workers", frame_size);
+    _benchmark_result.at(name).set_parameter("workers", _num_threads);
   }
 
+  // the single threaded frame is not needed anymore: return it to the pool before the per-thread frames are leased
+  compressed_data = utils::Buffer<char>();
+
+  // multi threaded: every thread compresses its partition of input into an independent frame that is stored at
+  // frames[thread_id * frame_capacity] using its own engine
+  utils::Buffer<char> frames;
+  std::vector<size_t> frame_sizes;
+  std::vector<compression::Engine> engines;
+  size_t frame_capacity = 0;
+  auto prepare_frames = [&](size_t num_threads) {
+    frame_capacity = compression::compress_bound(input.size() / num_threads + input.size() % num_threads);
+    if (frames.size() != frame_capacity * num_threads) {
+      frames = utils::Buffer<char>();
+      frames = _allocate<char>(frame_capacity * num_threads);
+    }
+    frame_sizes.assign(num_threads, 0);
+    engines.resize(num_threads);
+  };
+  auto compress_partition = [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(input.size(), thread_id, num_threads);
+    frame_sizes[thread_id] = engines[thread_id].compress(input.data() + begin, end - begin,
+                                                         frames.data() + thread_id * frame_capacity, frame_capacity);
+  };
+  auto frames_size = [&] { return std::accumulate(frame_sizes.begin(), frame_sizes.end(), size_t(0)); };
+
   {  // compression multi thread
-    std::string name("Compression (ZStandard)");
-    _register_benchmark(plain_data.size(), 0, name);
+    std::string name("Compression (ZStandard" + suffix + ")");
+    _register_benchmark(input.size(), 0, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      for (auto& thread : threads) {
-        thread.compressed_data.resize(thread.plain_data.size());
-      }
-      timer.start();
-      for (auto& thread : threads) {
-        thread.thread =
-            std::thread(compression::compress, std::ref(thread.plain_data), std::ref(thread.compressed_data));
-      }
-      for (auto& thread : threads) {
-        if (thread.thread.joinable()) {
-          thread.thread.join();
-        }
-      }
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      compressed_data.resize(plain_data.size());
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure_parallel(name, runtime, _num_threads, compress_partition, prepare_frames);
+    set_parameters(name, "chunked_frames", frames_size());
   }
 
   {  // decompression multi thread
-    std::string name("Decompression (ZStandard)");
-    _register_benchmark(compressed_data.size(), 0, name);
+    std::string name("Decompression (ZStandard" + suffix + ")");
+    _register_benchmark(input.size(), 0, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      for (auto& thread : threads) {
-        thread.thread =
-            std::thread(compression::decompress, std::ref(thread.compressed_data), std::ref(thread.plain_data));
-      }
-      for (auto& thread : threads) {
-        if (thread.thread.joinable()) {
-          thread.thread.join();
-        }
-      }
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure_parallel(
+        name, runtime, _num_threads,
+        [&](size_t thread_id, size_t num_threads) {
+          auto [begin, end] = utils::partition(input.size(), thread_id, num_threads);
+          engines[thread_id].decompress(frames.data() + thread_id * frame_capacity, frame_sizes[thread_id],
+                                        output.data() + begin, end - begin);
+        },
+        [&](size_t num_threads) {
+          // the frames must have been compressed using the same number of threads
+          if (frame_sizes.size() != num_threads) {
+            prepare_frames(num_threads);
+            _worker_pool(num_threads).run([&](size_t thread_id) { compress_partition(thread_id, num_threads); });
+          }
+        });
+    set_parameters(name, "chunked_frames", frames_size());
   }
 
-  if (_verbosity != VERBOSITY::OFF) {
-    std::cout << std::endl;
+  frames = utils::Buffer<char>();
+  _run_compression_levels(runtime, input.first(std::min<size_t>(input.size(), compression_sweep_size)), parameters,
+                          suffix);
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::_run_compression_levels(seconds runtime, std::span<const char> input, const nlohmann::json& parameters,
+                                        const std::string& suffix) {
+  auto compressed_data = _allocate<char>(compression::compress_bound(input.size()));
+  compression::Engine engine;
+  // the time budget is split among the levels
+  seconds level_runtime = runtime / static_cast<double>(compression::levels.size());
+
+  for (auto level : compression::levels) {
+    std::string name(fmt::format("Compression (ZStandard, level {}{})", level, suffix));
+    _register_benchmark(input.size(), 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    engine.set_level(level);
+    size_t compressed_size = 0;
+    _measure(name, level_runtime, [&] {
+      compressed_size = engine.compress(input.data(), input.size(), compressed_data.data(), compressed_data.size());
+    });
+    auto& result = _benchmark_result.at(name);
+    result.set_parameter("level", level);
+    result.set_parameter("strategy", "single_frame");
+    result.set_parameter("ratio", static_cast<double>(input.size()) / static_cast<double>(compressed_size));
+    for (const auto& [key, value] : parameters.items()) {
+      result.set_parameter(key, value);
+    }
   }
 }
 
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_fft(seconds runtime) {
-  utils::Timer timer;
-
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  FFT Benchmarks:\n");
     std::cout << std::flush;
@@ -251,62 +514,221 @@ void Benchmark::run_fft(seconds runtime) {
     std::cout << std::flush;
   }
 
-  auto plain_data = utils::DataGenerator::vector<double>(S_2_MiB, 42);
+  auto plain_data = _allocate<double>(S_2_MiB);
+  // bounded samples: values spread over the whole double range overflow to inf/NaN in the transforms
+  utils::DataGenerator::fill(plain_data.data(), plain_data.size(), 42, -1.0, 1.0);
   std::valarray<std::complex<double>> data(plain_data.size());
   std::transform(plain_data.begin(), plain_data.end(), begin(data), [](auto v) { return v + 1; });
 
+  fft::Plan plan(S_2_MiB);
+  // floating point operations of a transform, reported as ops
+  auto flops = static_cast<uint64_t>(plan.flops());
+
   {  // FFT
     std::string name("Fast Fourier Transformation");
-    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), 0, name);
+    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), flops, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print("\r                                      ");
       fmt::print(fg(fmt::color::azure), "\r    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      fft::fft(data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure(name, runtime, [&] { fft::fft(data); });
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // Inverse FFT
     std::string name("Inverse Fast Fourier Transformation");
-    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), 0, name);
+    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), flops, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    _measure(name, runtime, [&] { fft::ifft(data); });
+    _print_o_per_second(_benchmark_result.at(name));
+  }
+
+  // the planned transforms start from the same input in every run
+  auto input = _allocate<std::complex<double>>(S_2_MiB);
+  auto output = _allocate<std::complex<double>>(S_2_MiB);
+  std::transform(plain_data.begin(), plain_data.end(), input.begin(), [](auto v) { return v + 1; });
+  utils::Timer timer;
+
+  {  // FFT (plan)
+    std::string name("Fast Fourier Transformation (plan)");
+    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), flops, name);
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
+    _measure(name, runtime, [&] {
+      std::copy(input.begin(), input.end(), output.begin());
       timer.start();
-      fft::ifft(data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+      plan.forward(output.data());
+      return timer.stop();
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(output.page_mode()));
+    _print_o_per_second(_benchmark_result.at(name));
+  }
+
+  {  // Inverse FFT (plan)
+    std::string name("Inverse Fast Fourier Transformation (plan)");
+    _register_benchmark(S_2_MiB * sizeof(std::complex<double>), flops, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
     }
+
+    _measure(name, runtime, [&] {
+      std::copy(input.begin(), input.end(), output.begin());
+      timer.start();
+      plan.inverse(output.data());
+      return timer.stop();
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(output.page_mode()));
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   if (_verbosity != VERBOSITY::OFF) {
     std::cout << std::endl;
   }
+
+  // multi threaded batches, the buffers hold the largest batch. The in place transforms start from the same input in
+  // every run, like the planned transforms above.
+  size_t max_points = std::max(fft_batch_points, fft_max_points);
+  auto complex_input = _allocate<std::complex<double>>(max_points);
+  auto complex_data = _allocate<std::complex<double>>(max_points);
+  utils::DataGenerator::fill(reinterpret_cast<double*>(complex_input.data()), 2 * max_points, 43, -1.0, 1.0);
+  auto restore = [&](size_t points) { std::copy_n(complex_input.begin(), points, complex_data.begin()); };
+  const nlohmann::json parameters{{"page_mode", to_string(complex_data.page_mode())}};
+
+  {  // complex FFT
+    std::optional<fft::Plan> batch_plan;
+    _run_fft_batches(
+        runtime, "Fast Fourier Transformation (batched)", S_1_KiB, sizeof(std::complex<double>),
+        [&](uint64_t points) {
+          batch_plan.emplace(points);
+          return batch_plan->flops();
+        },
+        [&](size_t index, size_t thread_id, size_t num_threads, std::barrier<>* barrier) {
+          auto* data = complex_data.data() + index * batch_plan->size();
+          if (barrier == nullptr) {
+            batch_plan->forward(data);
+          } else {
+            batch_plan->forward(data, thread_id, num_threads, *barrier);
+          }
+        },
+        restore, parameters);
+  }
+
+  {  // real to complex FFT: size / 2 + 1 coefficients of every transform are written to the complex buffer
+    auto real_data = _allocate<double>(max_points);
+    utils::DataGenerator::fill(real_data.data(), real_data.size(), 44, -1.0, 1.0);
+    std::optional<fft::RealPlan> batch_plan;
+    _run_fft_batches(
+        runtime, "Real Fast Fourier Transformation (batched)", S_1_KiB, sizeof(double),
+        [&](uint64_t points) {
+          batch_plan.emplace(points);
+          return batch_plan->flops();
+        },
+        [&](size_t index, size_t thread_id, size_t num_threads, std::barrier<>* barrier) {
+          const double* input = real_data.data() + index * batch_plan->size();
+          auto* output = complex_data.data() + index * (batch_plan->size() / 2 + 1);
+          if (barrier == nullptr) {
+            batch_plan->forward(input, output);
+          } else {
+            batch_plan->forward(input, output, thread_id, num_threads, *barrier);
+          }
+        },
+        {}, parameters);
+  }
+
+  {  // 2D FFT of square (or 2:1) tiles
+    auto buffer = _allocate<std::complex<double>>(max_points);
+    std::optional<fft::Plan2D> batch_plan;
+    _run_fft_batches(
+        runtime, "2D Fast Fourier Transformation (batched)", S_64_KiB, sizeof(std::complex<double>),
+        [&](uint64_t points) {
+          size_t rows = size_t(1) << (std::countr_zero(points) / 2);
+          batch_plan.emplace(rows, points / rows);
+          return batch_plan->flops();
+        },
+        [&](size_t index, size_t thread_id, size_t num_threads, std::barrier<>* barrier) {
+          size_t points = batch_plan->rows() * batch_plan->cols();
+          auto* data = complex_data.data() + index * points;
+          if (barrier == nullptr) {
+            batch_plan->forward(data, buffer.data() + index * points);
+          } else {
+            batch_plan->forward(data, buffer.data() + index * points, thread_id, num_threads, *barrier);
+          }
+        },
+        restore, parameters);
+  }
 }
 
 // _____________________________________________________________________________________________________________________
-void Benchmark::run_mmul(seconds runtime) {
-  utils::Timer timer;
+void Benchmark::_run_fft_batches(seconds runtime, const std::string& name, uint64_t points, size_t point_size,
+                                 const std::function<double(uint64_t)>& resize,
+                                 const std::function<void(size_t, size_t, size_t, std::barrier<>*)>& transform,
+                                 const std::function<void(size_t)>& restore, const nlohmann::json& parameters) {
+  size_t num_transforms = 1;
+  size_t batch_points = 0;
+  double flops = 0;
+  std::optional<std::barrier<>> barrier;
+  auto resize_batch = [&](uint64_t size) {
+    flops = resize(size);
+    num_transforms = std::max<uint64_t>(1, fft_batch_points / size);
+    batch_points = num_transforms * size;
+    return batch_points * point_size;
+  };
+  auto job = [&](size_t thread_id, size_t num_threads) {
+    if (num_transforms >= num_threads) {
+      auto [begin, end] = utils::partition(num_transforms, thread_id, num_threads);
+      for (size_t i = begin; i < end; ++i) {
+        transform(i, 0, 1, nullptr);
+      }
+    } else {
+      for (size_t i = 0; i < num_transforms; ++i) {
+        transform(i, thread_id, num_threads, &*barrier);
+      }
+    }
+  };
+  auto prepare = [&](size_t num_threads) {
+    barrier.emplace(static_cast<std::ptrdiff_t>(num_threads));
+    if (restore) {
+      restore(batch_points);
+    }
+  };
+  auto operations = [&](uint64_t) { return static_cast<uint64_t>(flops * static_cast<double>(num_transforms)); };
+
+  uint64_t data_size = resize_batch(points);
+  _register_benchmark(data_size, operations(points), name);
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::azure), "    {:40}", name);
+    std::cout << std::flush;
+  }
+  _measure_parallel(name, runtime, _num_threads, job, prepare);
+  _benchmark_result.at(name).set_parameter("points", points);
+  _benchmark_result.at(name).set_parameter("transforms", num_transforms);
+  for (const auto& [parameter, value] : parameters.items()) {
+    _benchmark_result.at(name).set_parameter(parameter, value);
+  }
+  _print_o_per_second(_benchmark_result.at(name));
+
+  std::vector<uint64_t> sizes;
+  for (uint64_t size = 1 << 8; size <= fft_max_points; size *= 2) {
+    sizes.push_back(size);
+  }
+  _measure_parallel_sweep(name, runtime, _num_threads, "points", sizes, resize_batch, job, prepare, {}, operations);
+  if (_verbosity != VERBOSITY::OFF) {
+    std::cout << std::endl;
+  }
+}
 
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_mmul(seconds runtime) {
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  Matrix Multiplication Benchmarks:\n");
     std::cout << std::flush;
@@ -331,17 +753,7 @@ void Benchmark::run_mmul(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
-      mmul::matrix_multiplication(matrix_0, matrix_1);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    _measure(name, runtime, [&] { mmul::matrix_multiplication(matrix_0, matrix_1); });
   }
 
   if (_verbosity != VERBOSITY::OFF) {
@@ -358,89 +770,315 @@ void Benchmark::run_sort(seconds runtime) {
     std::cout << std::flush;
   }
 
-  {  // sort int
-    std::string name("Sorting Integers");
-    _register_benchmark(S_16_MiB * sizeof(int), 0, name);
+  for (auto distribution : _distributions) {
+    _run_sort_engines<int>(runtime, "Integers", distribution);
+    _run_sort_engines<double>(runtime, "Floating Points", distribution);
+  }
+
+  for (auto payload : _record_payloads) {
+    switch (payload) {
+      case 16:
+        _run_record_sort<16>(runtime);
+        break;
+      case 32:
+        _run_record_sort<32>(runtime);
+        break;
+      case 64:
+        _run_record_sort<64>(runtime);
+        break;
+      case 128:
+        _run_record_sort<128>(runtime);
+        break;
+      default:
+        throw std::runtime_error("Unsupported record payload size: " + std::to_string(payload));
+    }
+  }
+
+  if (!_input_file.empty()) {  // newline delimited keys of the user supplied file, sorted as views into the mapping
+    std::string name("Sorting Strings (file)");
+    utils::MappedFile file(_input_file);
+    auto lines = file.lines();
+    _register_benchmark(file.size(), lines.size(), name);
     if (_verbosity != VERBOSITY::OFF) {
-      fmt::print("\r                                              ");
-      fmt::print(fg(fmt::color::azure), "\r    {:40}", name);
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      auto data = utils::DataGenerator::vector<int>(S_16_MiB, static_cast<unsigned>(rt.count()));
+    std::vector<std::string_view> data;
+    _measure(name, runtime, [&] {
+      data = lines;
       timer.start();
       sort::sort(data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+      return timer.stop();
+    });
+    _benchmark_result.at(name).set_parameter("input", file.path());
+    _benchmark_result.at(name).set_parameter("lines", lines.size());
+    _print_o_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
     }
-  }
 
-  {  // sort double
-    std::string name("Sorting Floating Points");
-    _register_benchmark(S_16_MiB * sizeof(double), 0, name);
+    // the lines are already contiguous: the handles point into the mapping
+    std::vector<string_sort::Handle> handles;
+    handles.reserve(lines.size());
+    for (auto line : lines) {
+      handles.push_back(string_sort::make_handle(file.data(), line.data() - file.data(), line.size()));
+    }
+    _run_string_sort_engines(runtime, file.data(), file.size(), handles, ", file");
+  } else {  // sort std::string
+    std::string name("Sorting Strings");
+    _register_benchmark(S_2_MiB, S_2_MiB, name);
     if (_verbosity != VERBOSITY::OFF) {
-      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      auto data = utils::DataGenerator::vector<double>(S_16_MiB, static_cast<unsigned>(rt.count()));
+    unsigned seed = 0;
+    _measure(name, runtime, [&] {
+      auto data = utils::DataGenerator::vector<std::string>(S_2_MiB, seed++);
       timer.start();
       sort::sort(data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+      return timer.stop();
+    });
+    _print_o_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
     }
+
+    // the same strings (seed 0) copied back to back into an arena
+    string_sort::StringArena arena;
+    {
+      auto data = utils::DataGenerator::vector<std::string>(S_2_MiB, 0);
+      size_t num_chars = 0;
+      for (const auto& str : data) {
+        num_chars += str.size();
+      }
+      arena.reserve(data.size(), num_chars);
+      for (const auto& str : data) {
+        arena.add(str);
+      }
+    }
+    _run_string_sort_engines(runtime, arena.chars(), arena.num_chars(), arena.handles(), "");
   }
+}
 
-  {  // sort std::string
-    std::string name("Sorting Strings");
-    _register_benchmark(S_2_MiB, 0, name);
+// _____________________________________________________________________________________________________________________
+void Benchmark::_run_string_sort_engines(seconds runtime, const char* chars, size_t num_chars,
+                                         const std::vector<string_sort::Handle>& handles, const std::string& suffix) {
+  utils::Timer timer;
+  auto data = _allocate<string_sort::Handle>(handles.size());
+  auto buffer = _allocate<string_sort::Handle>(handles.size());
+
+  auto run = [&](const std::string& engine, const std::function<void()>& sort_fn) {
+    std::string name = "Sorting Strings (arena, " + engine + suffix + ")";
+    // one operation per string
+    _register_benchmark(num_chars + data.bytes(), data.size(), name);
     if (_verbosity != VERBOSITY::OFF) {
-      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
       std::cout << std::flush;
     }
-
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      auto data = utils::DataGenerator::vector<std::string>(S_2_MiB, static_cast<unsigned>(rt.count()));
+    _measure(name, runtime, [&] {
+      std::copy(handles.begin(), handles.end(), data.data());
       timer.start();
-      sort::sort(data);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+      sort_fn();
+      return timer.stop();
+    });
+    _benchmark_result.at(name).set_parameter("strings", handles.size());
+    _benchmark_result.at(name).set_parameter("chars", num_chars);
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_o_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
     }
+  };
+
+  run("std::sort", [&] { string_sort::std_sort(data.data(), data.size(), chars); });
+  run("multikey quicksort", [&] { string_sort::multikey_quicksort(data.data(), data.size(), chars); });
+  run("MSD radix sort", [&] { string_sort::msd_radix_sort(data.data(), data.size(), chars, buffer.data()); });
+}
+
+// _____________________________________________________________________________________________________________________
+template <typename T>
+void Benchmark::_run_sort_engines(seconds runtime, const std::string& type_name, utils::Distribution distribution) {
+  utils::Timer timer;
+  auto data = _allocate<T>(S_16_MiB);
+  auto buffer = _allocate<T>(S_16_MiB);
+  unsigned seed = 0;
+  auto generate = [&] {
+    if constexpr (std::is_floating_point_v<T>) {
+      utils::DataGenerator::fill(data.data(), data.size(), seed++, distribution, T(0), T(1));
+    } else {
+      utils::DataGenerator::fill(data.data(), data.size(), seed++, distribution);
+    }
+  };
+
+  // std::sort on uniform inputs keeps the plain name
+  auto start = [&](const std::string& engine) {
+    std::string labels = engine;
+    if (distribution != utils::Distribution::UNIFORM) {
+      labels += (labels.empty() ? "" : ", ") + to_string(distribution);
+    }
+    std::string name = "Sorting " + type_name + (labels.empty() ? "" : " (" + labels + ")");
+    // one operation per element
+    _register_benchmark(data.bytes(), data.size(), name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
+      std::cout << std::flush;
+    }
+    return name;
+  };
+  auto finish = [&](const std::string& name) {
+    _benchmark_result.at(name).set_parameter("distribution", to_string(distribution));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_o_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  };
+
+  {  // std::sort
+    auto name = start("");
+    _measure(name, runtime, [&] {
+      generate();
+      timer.start();
+      sort::sort(data.data(), data.size());
+      return timer.stop();
+    });
+    finish(name);
   }
 
-  if (_verbosity != VERBOSITY::OFF) {
-    std::cout << std::endl;
+  {  // std::sort with execution policy
+    auto name = start("parallel std::sort");
+    _measure(name, runtime, [&] {
+      generate();
+      timer.start();
+      sort::parallel_std_sort(data.data(), data.size());
+      return timer.stop();
+    });
+    _benchmark_result.at(name).set_parameter("execution_policies", sort::has_execution_policies);
+    finish(name);
+  }
+
+  {  // sample sort
+    auto name = start("sample sort");
+    std::optional<sort::SampleSort<T>> sorter;
+    _measure_parallel(
+        name, runtime, _num_threads, [&](size_t thread_id, size_t) { (*sorter)(thread_id); },
+        [&](size_t num_threads) {
+          generate();
+          sorter.emplace(data.data(), data.size(), buffer.data(), num_threads);
+        });
+    finish(name);
+  }
+
+  {  // radix sort
+    auto name = start("radix sort");
+    std::optional<sort::RadixSort<T>> sorter;
+    _measure_parallel(
+        name, runtime, _num_threads, [&](size_t thread_id, size_t) { (*sorter)(thread_id); },
+        [&](size_t num_threads) {
+          generate();
+          sorter.emplace(data.data(), data.size(), buffer.data(), num_threads);
+        });
+    finish(name);
   }
 }
 
 // _____________________________________________________________________________________________________________________
-void Benchmark::run_synthetic(seconds runtime) {
+template <size_t Payload>
+void Benchmark::_run_record_sort(seconds runtime) {
+  using Record = sort::Record<Payload>;
   utils::Timer timer;
+  // 128 MiB of records per layout
+  const size_t size = S_128_MiB / sizeof(Record);
+  unsigned seed = 0;
+  auto keys = _allocate<uint64_t>(size);
+
+  auto start = [&](const std::string& layout) {
+    std::string name = fmt::format("Sorting Records ({}, {} B payload)", layout, Payload);
+    // one operation per record
+    _register_benchmark(size * sizeof(Record), size, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
+      std::cout << std::flush;
+    }
+    return name;
+  };
+  auto finish = [&](const std::string& name, const std::string& layout) {
+    _benchmark_result.at(name).set_parameter("layout", layout);
+    _benchmark_result.at(name).set_parameter("payload_bytes", Payload);
+    _benchmark_result.at(name).set_parameter("records", size);
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(keys.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  };
+
+  {  // array of structs: the records are moved while sorting
+    auto name = start("AoS");
+    auto records = _allocate<Record>(size);
+    utils::DataGenerator::fill(reinterpret_cast<uint64_t*>(records.data()), records.bytes() / sizeof(uint64_t), 1);
+    _measure(name, runtime, [&] {
+      utils::DataGenerator::fill(keys.data(), size, seed++);
+      for (size_t i = 0; i < size; ++i) {
+        records[i].key = keys[i];
+      }
+      timer.start();
+      sort::sort_records(records.data(), size);
+      return timer.stop();
+    });
+    finish(name, "AoS");
+  }
+
+  {  // struct of arrays: the key column is sorted with indices, payloads are gathered
+    auto name = start("SoA");
+    auto payloads = _allocate<char>(size * Payload);
+    auto index = _allocate<sort::KeyIndex>(size);
+    auto keys_out = _allocate<uint64_t>(size);
+    auto payloads_out = _allocate<char>(size * Payload);
+    utils::DataGenerator::fill(reinterpret_cast<uint64_t*>(payloads.data()), payloads.bytes() / sizeof(uint64_t), 1);
+    _measure(name, runtime, [&] {
+      utils::DataGenerator::fill(keys.data(), size, seed++);
+      timer.start();
+      sort::sort_columns<Payload>(keys.data(), payloads.data(), size, index.data(), keys_out.data(),
+                                  payloads_out.data());
+      return timer.stop();
+    });
+    finish(name, "SoA");
+  }
 
+  {  // key and index sorted separately, records are gathered afterwards
+    auto name = start("key+index");
+    auto records = _allocate<Record>(size);
+    auto index = _allocate<sort::KeyIndex>(size);
+    auto output = _allocate<Record>(size);
+    utils::DataGenerator::fill(reinterpret_cast<uint64_t*>(records.data()), records.bytes() / sizeof(uint64_t), 1);
+    _measure(name, runtime, [&] {
+      utils::DataGenerator::fill(keys.data(), size, seed++);
+      for (size_t i = 0; i < size; ++i) {
+        records[i].key = keys[i];
+      }
+      timer.start();
+      sort::sort_records_by_index(records.data(), size, index.data(), output.data());
+      return timer.stop();
+    });
+    finish(name, "key+index");
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_synthetic(seconds runtime) {
   if (_verbosity != VERBOSITY::OFF) {
     fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  Synthetic Benchmarks:\n");
     std::cout << std::flush;
   }
 
-  auto int_data = utils::DataGenerator::vector<int>(10, 3, 1, 342);
-  auto fp_data = utils::DataGenerator::vector<double>(10, 3, 1, 342);
+  auto int_data = _allocate<int>(10);
+  auto fp_data = _allocate<double>(10);
+  utils::DataGenerator::fill(int_data.data(), int_data.size(), 3, 1, 342);
+  utils::DataGenerator::fill(fp_data.data(), fp_data.size(), 3, 1.0, 342.0);
+  const auto page_mode = to_string(int_data.page_mode());
 
   int int_threshold = std::numeric_limits<int>::max() -
                       std::accumulate(int_data.begin(), int_data.end(), 1, [](auto a, auto b) { return a * b; });
@@ -454,19 +1092,12 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::add_sub(_num_ops / 100, int_data[0], int_data[1], int_data[2], int_data[3], int_data[4], int_data[5],
                          int_data[6], int_data[7], int_data[8], int_data[9]);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // mul (int)
@@ -477,19 +1108,12 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::mul(_num_ops / 100, int_data[0], int_data[1], int_data[2], int_data[3], int_data[4], int_data[5],
                      int_data[6], int_data[7], int_data[8], int_data[9], int_threshold);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // div (int)
@@ -500,19 +1124,12 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::div(_num_ops_div / 100, int_data[0], int_data[1], int_data[2], int_data[3], int_data[4], int_data[5],
                      int_data[6], int_data[7], int_data[8], int_data[9]);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // add/sub (double)
@@ -523,19 +1140,12 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::add_sub(_num_ops / 100, fp_data[0], fp_data[1], fp_data[2], fp_data[3], fp_data[4], fp_data[5],
                          fp_data[6], fp_data[7], fp_data[8], fp_data[9]);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // mul (double)
@@ -546,19 +1156,12 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::mul(_num_ops / 100, fp_data[0], fp_data[1], fp_data[2], fp_data[3], fp_data[4], fp_data[5], fp_data[6],
                      fp_data[7], fp_data[8], fp_data[9], std::numeric_limits<double>::max());
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
-    }
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   {  // div (int)
@@ -569,19 +1172,46 @@ void Benchmark::run_synthetic(seconds runtime) {
       std::cout << std::flush;
     }
 
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      timer.start();
+    _measure(name, runtime, [&] {
       synthetic::div(_num_ops_div / 100, fp_data[0], fp_data[1], fp_data[2], fp_data[3], fp_data[4], fp_data[5],
                      fp_data[6], fp_data[7], fp_data[8], fp_data[9]);
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_o_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
+  }
+
+  {  // add/sub (int) multi thread
+    std::string name("Synthetic: IOPS (add/sub, multi thread)");
+    _register_benchmark(0, _num_ops, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(_num_ops / 100, thread_id, num_threads);
+      synthetic::add_sub(end - begin, int_data[0], int_data[1], int_data[2], int_data[3], int_data[4], int_data[5],
+                         int_data[6], int_data[7], int_data[8], int_data[9]);
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
+  }
+
+  {  // add/sub (double) multi thread
+    std::string name("Synthetic: FLOPS (add/sub, multi thread)");
+    _register_benchmark(0, _num_ops, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "\n    {:40}", name);
+      std::cout << std::flush;
     }
+
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(_num_ops / 100, thread_id, num_threads);
+      synthetic::add_sub(end - begin, fp_data[0], fp_data[1], fp_data[2], fp_data[3], fp_data[4], fp_data[5],
+                         fp_data[6], fp_data[7], fp_data[8], fp_data[9]);
+    });
+    _benchmark_result.at(name).set_parameter("page_mode", page_mode);
+    _print_o_per_second(_benchmark_result.at(name));
   }
 
   if (_verbosity != VERBOSITY::OFF) {
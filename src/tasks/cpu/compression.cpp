@@ -9,11 +9,15 @@
 #include <taskbench/utils/data_generator.h>
 #include <zstd.h>
 
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 namespace taskbench::cpu::compression {
 
 // _____________________________________________________________________________________________________________________
 void compress(const std::vector<char>& src, std::vector<char>& dst) {
-  auto size = ZSTD_compress((void*)dst.data(), dst.size(), src.data(), src.size(), 9);
+  auto size = ZSTD_compress((void*)dst.data(), dst.size(), src.data(), src.size(), default_level);
   dst.resize(size);
 }
 
@@ -22,4 +26,96 @@ void decompress(const std::vector<char>& src, std::vector<char>& dst) {
   ZSTD_decompress((void*)dst.data(), dst.size(), src.data(), src.size());
 }
 
+// _____________________________________________________________________________________________________________________
+size_t compress(const char* src, size_t src_size, char* dst, size_t dst_capacity) {
+  return ZSTD_compress(dst, dst_capacity, src, src_size, default_level);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t decompress(const char* src, size_t src_size, char* dst, size_t dst_capacity) {
+  return ZSTD_decompress(dst, dst_capacity, src, src_size);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t compress_bound(size_t src_size) { return ZSTD_compressBound(src_size); }
+
+// _____________________________________________________________________________________________________________________
+bool supports_workers() { return ZSTD_cParam_getBounds(ZSTD_c_nbWorkers).upperBound > 0; }
+
+/**
+ * @brief Throw std::runtime_error if result is a ZStandard error code, otherwise return it
+ */
+static size_t check(size_t result, const char* what) {
+  if (ZSTD_isError(result) != 0) {
+    throw std::runtime_error(std::string(what) + ": " + ZSTD_getErrorName(result));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________________________________________________
+Engine::Engine(int level, int num_workers) : _cctx(ZSTD_createCCtx()), _dctx(ZSTD_createDCtx()) {
+  if (_cctx == nullptr || _dctx == nullptr) {
+    ZSTD_freeCCtx(_cctx);
+    ZSTD_freeDCtx(_dctx);
+    throw std::runtime_error("Failed to create ZStandard contexts.");
+  }
+  set_level(level);
+  set_num_workers(num_workers);
+}
+
+// _____________________________________________________________________________________________________________________
+Engine::~Engine() {
+  ZSTD_freeCCtx(_cctx);
+  ZSTD_freeDCtx(_dctx);
+}
+
+// _____________________________________________________________________________________________________________________
+Engine::Engine(Engine&& other) noexcept
+    : _cctx(std::exchange(other._cctx, nullptr)),
+      _dctx(std::exchange(other._dctx, nullptr)),
+      _level(other._level),
+      _num_workers(other._num_workers) {}
+
+// _____________________________________________________________________________________________________________________
+Engine& Engine::operator=(Engine&& other) noexcept {
+  if (this != &other) {
+    ZSTD_freeCCtx(_cctx);
+    ZSTD_freeDCtx(_dctx);
+    _cctx = std::exchange(other._cctx, nullptr);
+    _dctx = std::exchange(other._dctx, nullptr);
+    _level = other._level;
+    _num_workers = other._num_workers;
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________________________________________________
+void Engine::set_level(int level) {
+  check(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, level), "Unsupported ZStandard compression level");
+  _level = level;
+}
+
+// _____________________________________________________________________________________________________________________
+int Engine::level() const { return _level; }
+
+// _____________________________________________________________________________________________________________________
+void Engine::set_num_workers(int num_workers) {
+  check(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_nbWorkers, num_workers), "Unsupported number of ZStandard workers");
+  _num_workers = num_workers;
+}
+
+// _____________________________________________________________________________________________________________________
+int Engine::num_workers() const { return _num_workers; }
+
+// _____________________________________________________________________________________________________________________
+size_t Engine::compress(const char* src, size_t src_size, char* dst, size_t dst_capacity) {
+  // the parameters are sticky: ZSTD_compress2 only resets the session, not the level and the number of workers
+  return check(ZSTD_compress2(_cctx, dst, dst_capacity, src, src_size), "ZStandard compression failed");
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Engine::decompress(const char* src, size_t src_size, char* dst, size_t dst_capacity) {
+  return check(ZSTD_decompressDCtx(_dctx, dst, dst_capacity, src, src_size), "ZStandard decompression failed");
+}
+
 }  // namespace taskbench::cpu::compression
\ No newline at end of file
@@ -6,6 +6,19 @@
  */
 
 #include <taskbench/tasks/cpu/fft.h>
+#include <taskbench/utils/cpu_features.h>
+#include <taskbench/utils/worker_pool.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
 
 namespace taskbench::cpu::fft {
 
@@ -34,4 +47,321 @@ void ifft(std::valarray<std::complex<double>>& data) {
   data = data.apply(std::conj) / data.size();
 }
 
+// points of the blocks whose stages are executed before moving on to the next block (32 KiB)
+static constexpr size_t block_size = 2048;
+// points per side of the tiles of the 2D transposes (4 KiB)
+static constexpr size_t tile_size = 16;
+
+/**
+ * @brief count butterflies u[k], v[k] = u[k] + w[k] * v[k], u[k] - w[k] * v[k] on interleaved complex numbers
+ */
+using Butterflies = void (*)(double* u, double* v, const double* w, size_t count);
+
+// _____________________________________________________________________________________________________________________
+static void scalar_butterflies(double* u, double* v, const double* w, size_t count) {
+  for (size_t k = 0; k < count; ++k) {
+    // t = w * v (without the inf/nan handling of std::complex)
+    double tr = w[2 * k] * v[2 * k] - w[2 * k + 1] * v[2 * k + 1];
+    double ti = w[2 * k] * v[2 * k + 1] + w[2 * k + 1] * v[2 * k];
+    v[2 * k] = u[2 * k] - tr;
+    v[2 * k + 1] = u[2 * k + 1] - ti;
+    u[2 * k] += tr;
+    u[2 * k + 1] += ti;
+  }
+}
+
+#if defined(TASKBENCH_X86)
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_butterflies(double* u, double* v, const double* w, size_t count) {
+  size_t k = 0;
+  // two complex numbers per vector
+  for (; k + 2 <= count; k += 2) {
+    __m256d wk = _mm256_loadu_pd(w + 2 * k);
+    __m256d vk = _mm256_loadu_pd(v + 2 * k);
+    __m256d uk = _mm256_loadu_pd(u + 2 * k);
+    __m256d re = _mm256_movedup_pd(wk);
+    __m256d im = _mm256_permute_pd(wk, 0xf);
+    __m256d swapped = _mm256_permute_pd(vk, 0x5);
+    __m256d t = _mm256_addsub_pd(_mm256_mul_pd(re, vk), _mm256_mul_pd(im, swapped));
+    _mm256_storeu_pd(u + 2 * k, _mm256_add_pd(uk, t));
+    _mm256_storeu_pd(v + 2 * k, _mm256_sub_pd(uk, t));
+  }
+  scalar_butterflies(u + 2 * k, v + 2 * k, w + 2 * k, count - k);
+}
+#endif
+
+/**
+ * @brief Butterflies [begin, end) of the stage combining transforms of length h (butterfly b combines the points
+ *  start + k and start + h + k with start = 2h * (b / h) and k = b % h)
+ */
+static void stage(std::complex<double>* data, size_t h, const std::complex<double>* twiddles, size_t begin,
+                  size_t end, Butterflies butterflies) {
+  auto* values = reinterpret_cast<double*>(data);
+  if (h == 1) {  // twiddle 1
+    for (size_t b = begin; b < end; ++b) {
+      double* u = values + 4 * b;
+      double ur = u[0], ui = u[1];
+      u[0] = ur + u[2];
+      u[1] = ui + u[3];
+      u[2] = ur - u[2];
+      u[3] = ui - u[3];
+    }
+    return;
+  }
+  const auto* w = reinterpret_cast<const double*>(twiddles + h);
+  for (size_t b = begin; b < end;) {
+    size_t start = 2 * h * (b / h);
+    size_t k = b % h;
+    size_t count = std::min(h - k, end - b);
+    butterflies(values + 2 * (start + k), values + 2 * (start + h + k), w + 2 * k, count);
+    b += count;
+  }
+}
+
+/**
+ * @brief Blocked copy of the tile rows [begin, end) of the rows x cols matrix src to dst transposed
+ */
+static void transpose(const std::complex<double>* src, std::complex<double>* dst, size_t rows, size_t cols,
+                      size_t begin, size_t end) {
+  for (size_t r0 = begin * tile_size; r0 < std::min(end * tile_size, rows); r0 += tile_size) {
+    for (size_t c0 = 0; c0 < cols; c0 += tile_size) {
+      for (size_t r = r0; r < std::min(r0 + tile_size, rows); ++r) {
+        for (size_t c = c0; c < std::min(c0 + tile_size, cols); ++c) {
+          dst[c * rows + r] = src[r * cols + c];
+        }
+      }
+    }
+  }
+}
+
+static void synchronize(std::barrier<>* barrier) {
+  if (barrier != nullptr) {
+    barrier->arrive_and_wait();
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+Plan::Plan(size_t size) : _size(size) {
+  if (!std::has_single_bit(size) || size > (size_t(1) << 32)) {
+    throw std::runtime_error("FFT size must be a power of two, got " + std::to_string(size));
+  }
+  auto bits = static_cast<unsigned>(std::countr_zero(size));
+  for (size_t i = 0; i < size; ++i) {
+    size_t j = 0;
+    for (unsigned b = 0; b < bits; ++b) {
+      j |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    if (i < j) {
+      _swaps.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(j));
+    }
+  }
+  _twiddles.resize(size);
+  for (size_t h = 1; h < size; h *= 2) {
+    for (size_t k = 0; k < h; ++k) {
+      _twiddles[h + k] = std::polar(1.0, -M_PI * static_cast<double>(k) / static_cast<double>(h));
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan::forward(std::complex<double>* data) const { _execute(data, 0, 1, nullptr); }
+
+// _____________________________________________________________________________________________________________________
+void Plan::forward(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>& barrier) const {
+  _execute(data, thread_id, num_threads, &barrier);
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan::inverse(std::complex<double>* data) const {
+  // the inverse transform of x at k is the forward transform at size - k
+  _execute(data, 0, 1, nullptr);
+  _reverse(data, 0, _size / 2 + 1);
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan::inverse(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>& barrier) const {
+  _execute(data, thread_id, num_threads, &barrier);
+  barrier.arrive_and_wait();
+  auto [begin, end] = utils::partition(_size / 2 + 1, thread_id, num_threads);
+  _reverse(data, begin, end);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Plan::size() const { return _size; }
+
+// _____________________________________________________________________________________________________________________
+double Plan::flops() const {
+  return 5.0 * static_cast<double>(_size) * static_cast<double>(std::countr_zero(_size));
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan::_execute(std::complex<double>* data, size_t thread_id, size_t num_threads, std::barrier<>* barrier) const {
+#if defined(TASKBENCH_X86)
+  static const Butterflies butterflies = utils::cpu_features().avx2 ? avx2_butterflies : scalar_butterflies;
+#else
+  static const Butterflies butterflies = scalar_butterflies;
+#endif
+  {
+    auto [begin, end] = utils::partition(_swaps.size(), thread_id, num_threads);
+    for (size_t i = begin; i < end; ++i) {
+      std::swap(data[_swaps[i].first], data[_swaps[i].second]);
+    }
+  }
+  synchronize(barrier);
+
+  // stages within a block: all of them per block
+  size_t block = std::min(_size, block_size);
+  {
+    auto [begin, end] = utils::partition(_size / block, thread_id, num_threads);
+    for (size_t i = begin; i < end; ++i) {
+      for (size_t h = 1; h < block; h *= 2) {
+        stage(data + i * block, h, _twiddles.data(), 0, block / 2, butterflies);
+      }
+    }
+  }
+  for (size_t h = block; h < _size; h *= 2) {
+    synchronize(barrier);
+    auto [begin, end] = utils::partition(_size / 2, thread_id, num_threads);
+    stage(data, h, _twiddles.data(), begin, end, butterflies);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan::_reverse(std::complex<double>* data, size_t begin, size_t end) const {
+  double scale = 1.0 / static_cast<double>(_size);
+  for (size_t k = begin; k < end; ++k) {
+    size_t j = (_size - k) % _size;
+    if (k < j) {
+      std::swap(data[k], data[j]);
+      data[j] *= scale;
+    }
+    data[k] *= scale;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+RealPlan::RealPlan(size_t size) : _size(size), _plan(std::max<size_t>(size / 2, 1)) {
+  if (!std::has_single_bit(size) || size < 4) {
+    throw std::runtime_error("Real FFT size must be a power of two of at least 4, got " + std::to_string(size));
+  }
+  _twiddles.resize(size / 2 + 1);
+  for (size_t k = 0; k < _twiddles.size(); ++k) {
+    _twiddles[k] = std::polar(1.0, -2 * M_PI * static_cast<double>(k) / static_cast<double>(size));
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void RealPlan::forward(const double* input, std::complex<double>* output) const {
+  size_t half = _size / 2;
+  _pack(input, output, 0, half);
+  _plan.forward(output);
+  _split(output, 0, half / 2 + 1);
+}
+
+// _____________________________________________________________________________________________________________________
+void RealPlan::forward(const double* input, std::complex<double>* output, size_t thread_id, size_t num_threads,
+                       std::barrier<>& barrier) const {
+  size_t half = _size / 2;
+  {
+    auto [begin, end] = utils::partition(half, thread_id, num_threads);
+    _pack(input, output, begin, end);
+  }
+  barrier.arrive_and_wait();
+  _plan.forward(output, thread_id, num_threads, barrier);
+  barrier.arrive_and_wait();
+  auto [begin, end] = utils::partition(half / 2 + 1, thread_id, num_threads);
+  _split(output, begin, end);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t RealPlan::size() const { return _size; }
+
+// _____________________________________________________________________________________________________________________
+double RealPlan::flops() const {
+  return 2.5 * static_cast<double>(_size) * static_cast<double>(std::countr_zero(_size));
+}
+
+// _____________________________________________________________________________________________________________________
+void RealPlan::_pack(const double* input, std::complex<double>* output, size_t begin, size_t end) const {
+  // even values become the real parts, odd values the imaginary parts
+  for (size_t i = begin; i < end; ++i) {
+    output[i] = {input[2 * i], input[2 * i + 1]};
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void RealPlan::_split(std::complex<double>* output, size_t begin, size_t end) const {
+  // Z = FFT(packed): X[k] = (Z[k] + conj(Z[m - k])) / 2 - i / 2 * w^k * (Z[k] - conj(Z[m - k])), m = size / 2
+  size_t half = _size / 2;
+  const std::complex<double> i_half(0, 0.5);
+  for (size_t k = begin; k < end; ++k) {
+    if (k == 0) {
+      auto z = output[0];
+      output[0] = z.real() + z.imag();
+      output[half] = z.real() - z.imag();
+      continue;
+    }
+    auto a = output[k];
+    auto b = output[half - k];
+    output[k] = 0.5 * (a + std::conj(b)) - i_half * _twiddles[k] * (a - std::conj(b));
+    if (k != half - k) {
+      output[half - k] = 0.5 * (b + std::conj(a)) - i_half * _twiddles[half - k] * (b - std::conj(a));
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+Plan2D::Plan2D(size_t rows, size_t cols) : _row_plan(cols), _column_plan(rows) {}
+
+// _____________________________________________________________________________________________________________________
+void Plan2D::forward(std::complex<double>* data, std::complex<double>* buffer) const {
+  _execute(data, buffer, 0, 1, nullptr);
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan2D::forward(std::complex<double>* data, std::complex<double>* buffer, size_t thread_id, size_t num_threads,
+                     std::barrier<>& barrier) const {
+  _execute(data, buffer, thread_id, num_threads, &barrier);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Plan2D::rows() const { return _column_plan.size(); }
+
+// _____________________________________________________________________________________________________________________
+size_t Plan2D::cols() const { return _row_plan.size(); }
+
+// _____________________________________________________________________________________________________________________
+double Plan2D::flops() const {
+  double points = static_cast<double>(rows() * cols());
+  return 5.0 * points * std::log2(points);
+}
+
+// _____________________________________________________________________________________________________________________
+void Plan2D::_execute(std::complex<double>* data, std::complex<double>* buffer, size_t thread_id, size_t num_threads,
+                      std::barrier<>* barrier) const {
+  size_t rows = this->rows();
+  size_t cols = this->cols();
+  {
+    auto [begin, end] = utils::partition(rows, thread_id, num_threads);
+    for (size_t r = begin; r < end; ++r) {
+      _row_plan.forward(data + r * cols);
+    }
+  }
+  synchronize(barrier);
+  {
+    auto [begin, end] = utils::partition((rows + tile_size - 1) / tile_size, thread_id, num_threads);
+    transpose(data, buffer, rows, cols, begin, end);
+  }
+  synchronize(barrier);
+  {
+    auto [begin, end] = utils::partition(cols, thread_id, num_threads);
+    for (size_t c = begin; c < end; ++c) {
+      _column_plan.forward(buffer + c * rows);
+    }
+  }
+  synchronize(barrier);
+  auto [begin, end] = utils::partition((cols + tile_size - 1) / tile_size, thread_id, num_threads);
+  transpose(buffer, data, cols, rows, begin, end);
+}
+
 }  // namespace taskbench::cpu::fft
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/cpu/string_sort.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace taskbench::cpu::string_sort {
+
+// buckets smaller than this are sorted by insertion sort (multikey quicksort) or multikey quicksort (radix sort)
+static constexpr size_t insertion_sort_threshold = 16;
+static constexpr size_t radix_sort_threshold = 64;
+// radix sort recurses once per character: deeper buckets (long common prefixes) are finished by multikey quicksort,
+// which continues its equal partition iteratively, so that the recursion depth stays bounded
+static constexpr size_t radix_sort_max_depth = 32;
+
+/**
+ * @brief Character depth of the string of handle + 1, or 0 if the string ends before depth
+ */
+static int char_at(const Handle& handle, size_t depth, const char* chars) {
+  if (depth >= handle.length) {
+    return 0;
+  }
+  if (depth < sizeof(handle.prefix)) {
+    return static_cast<int>((handle.prefix >> (56 - 8 * depth)) & 0xff) + 1;
+  }
+  return static_cast<unsigned char>(chars[handle.offset + depth]) + 1;
+}
+
+/**
+ * @brief less for strings that are known to be equal in their first depth characters
+ */
+static bool less(const Handle& a, const Handle& b, size_t depth, const char* chars) {
+  if (depth < sizeof(a.prefix) && a.prefix != b.prefix) {
+    return a.prefix < b.prefix;
+  }
+  size_t from = std::max(depth, sizeof(a.prefix));
+  size_t common = std::min(a.length, b.length);
+  if (from < common) {
+    int cmp = std::memcmp(chars + a.offset + from, chars + b.offset + from, common - from);
+    if (cmp != 0) {
+      return cmp < 0;
+    }
+  }
+  return a.length < b.length;
+}
+
+// _____________________________________________________________________________________________________________________
+Handle make_handle(const char* chars, uint64_t offset, uint64_t length) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < sizeof(prefix); ++i) {
+    prefix <<= 8;
+    if (i < length) {
+      prefix |= static_cast<unsigned char>(chars[offset + i]);
+    }
+  }
+  return {prefix, offset, length};
+}
+
+// _____________________________________________________________________________________________________________________
+void StringArena::reserve(size_t num_strings, size_t num_chars) {
+  _handles.reserve(num_strings);
+  _chars.reserve(num_chars);
+}
+
+// _____________________________________________________________________________________________________________________
+void StringArena::add(std::string_view str) {
+  uint64_t offset = _chars.size();
+  _chars.insert(_chars.end(), str.begin(), str.end());
+  _handles.push_back(make_handle(_chars.data(), offset, str.size()));
+}
+
+// _____________________________________________________________________________________________________________________
+std::string_view StringArena::view(const Handle& handle) const {
+  return {_chars.data() + handle.offset, handle.length};
+}
+
+// _____________________________________________________________________________________________________________________
+const char* StringArena::chars() const { return _chars.data(); }
+
+// _____________________________________________________________________________________________________________________
+const std::vector<Handle>& StringArena::handles() const { return _handles; }
+
+// _____________________________________________________________________________________________________________________
+size_t StringArena::num_chars() const { return _chars.size(); }
+
+// _____________________________________________________________________________________________________________________
+bool less(const Handle& a, const Handle& b, const char* chars) { return less(a, b, 0, chars); }
+
+// _____________________________________________________________________________________________________________________
+void std_sort(Handle* handles, size_t size, const char* chars) {
+  std::sort(handles, handles + size, [chars](const Handle& a, const Handle& b) { return less(a, b, 0, chars); });
+}
+
+// _____________________________________________________________________________________________________________________
+static void insertion_sort(Handle* handles, size_t size, size_t depth, const char* chars) {
+  for (size_t i = 1; i < size; ++i) {
+    Handle handle = handles[i];
+    size_t j = i;
+    for (; j > 0 && less(handle, handles[j - 1], depth, chars); --j) {
+      handles[j] = handles[j - 1];
+    }
+    handles[j] = handle;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+static void multikey_quicksort(Handle* handles, size_t size, size_t depth, const char* chars) {
+  while (size > insertion_sort_threshold) {
+    // median of three
+    int a = char_at(handles[0], depth, chars);
+    int b = char_at(handles[size / 2], depth, chars);
+    int c = char_at(handles[size - 1], depth, chars);
+    int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+    // [0, lt): less, [lt, gt): equal, [gt, size): greater
+    size_t lt = 0, i = 0, gt = size;
+    while (i < gt) {
+      int ch = char_at(handles[i], depth, chars);
+      if (ch < pivot) {
+        std::swap(handles[lt++], handles[i++]);
+      } else if (ch > pivot) {
+        std::swap(handles[i], handles[--gt]);
+      } else {
+        ++i;
+      }
+    }
+    multikey_quicksort(handles, lt, depth, chars);
+    multikey_quicksort(handles + gt, size - gt, depth, chars);
+    if (pivot == 0) {
+      // all strings of the equal partition have ended
+      return;
+    }
+    handles += lt;
+    size = gt - lt;
+    ++depth;
+  }
+  insertion_sort(handles, size, depth, chars);
+}
+
+// _____________________________________________________________________________________________________________________
+void multikey_quicksort(Handle* handles, size_t size, const char* chars) {
+  multikey_quicksort(handles, size, 0, chars);
+}
+
+// _____________________________________________________________________________________________________________________
+static void msd_radix_sort(Handle* handles, size_t size, size_t depth, const char* chars, Handle* buffer) {
+  if (size < radix_sort_threshold || depth >= radix_sort_max_depth) {
+    multikey_quicksort(handles, size, depth, chars);
+    return;
+  }
+  // bucket 0: strings that end before depth, bucket c + 1: character c. A single array per level: it holds the bucket
+  // begins while distributing and the bucket ends afterwards.
+  std::array<size_t, 257> offsets{};
+  for (size_t i = 0; i < size; ++i) {
+    ++offsets[char_at(handles[i], depth, chars)];
+  }
+  size_t sum = 0;
+  for (auto& offset : offsets) {
+    sum += std::exchange(offset, sum);
+  }
+  for (size_t i = 0; i < size; ++i) {
+    buffer[offsets[char_at(handles[i], depth, chars)]++] = handles[i];
+  }
+  std::copy_n(buffer, size, handles);
+  // strings of bucket 0 are equal
+  for (size_t c = 1; c < offsets.size(); ++c) {
+    size_t begin = offsets[c - 1];
+    size_t bucket_size = offsets[c] - begin;
+    if (bucket_size > 1) {
+      msd_radix_sort(handles + begin, bucket_size, depth + 1, chars, buffer + begin);
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void msd_radix_sort(Handle* handles, size_t size, const char* chars, Handle* buffer) {
+  msd_radix_sort(handles, size, 0, chars, buffer);
+}
+
+}  // namespace taskbench::cpu::string_sort
\ No newline at end of file
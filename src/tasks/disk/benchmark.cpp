@@ -0,0 +1,78 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <fmt/color.h>
+#include <taskbench/tasks/disk/benchmark.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace taskbench::disk {
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_all(seconds runtime) {
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::beige) | fmt::emphasis::bold, "Disk Benchmarks:\n");
+    std::cout << std::flush;
+  }
+  run_external_sort(runtime);
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_directory(std::filesystem::path directory) { _directory = std::move(directory); }
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_memory_budget(uint64_t bytes) { _memory_budget = bytes; }
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_external_sort(seconds runtime) {
+  std::string name("External Sort");
+  size_t size = _array_size<uint64_t>(4 * _memory_budget);
+  TemporaryFiles files;
+  // named after this benchmark like the run files, so that concurrent runs sharing the directory do not collide
+  auto id = reinterpret_cast<uintptr_t>(this);
+  auto input = files.add(_directory / fmt::format("taskbench_external_sort_input_{}.tmp", id));
+  auto output = files.add(_directory / fmt::format("taskbench_external_sort_output_{}.tmp", id));
+  ExternalSort::generate(input, size, 0);
+
+  // one operation per element
+  _register_benchmark(size * sizeof(uint64_t), size, name);
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::azure), "    {:40}", name);
+    std::cout << std::flush;
+  }
+
+  ExternalSort sorter(_directory, static_cast<size_t>(_memory_budget), _worker_pool(_num_threads), _page_mode);
+  ExternalSortStats total;
+  size_t num_sorts = 0;
+  _measure(name, runtime, [&] {
+    auto stats = sorter(input, output);
+    total.run_generation += stats.run_generation;
+    total.merge += stats.merge;
+    total.num_runs = stats.num_runs;
+    total.num_merge_passes = stats.num_merge_passes;
+    total.page_mode = stats.page_mode;
+    ++num_sorts;
+    return stats.run_generation + stats.merge;
+  });
+  files.clear();
+
+  auto& result = _benchmark_result.at(name);
+  result.set_parameter("directory", _directory.string());
+  result.set_parameter("memory_budget", _memory_budget);
+  result.set_parameter("page_mode", to_string(total.page_mode));
+  result.set_parameter("runs", total.num_runs);
+  result.set_parameter("merge_passes", total.num_merge_passes);
+  result.set_parameter("run_generation", total.run_generation.count() / static_cast<double>(num_sorts));
+  result.set_parameter("merge", total.merge.count() / static_cast<double>(num_sorts));
+  _print_gib_per_second(result);
+  if (_verbosity != VERBOSITY::OFF) {
+    std::cout << std::endl;
+  }
+}
+
+}  // namespace taskbench::disk
\ No newline at end of file
@@ -0,0 +1,321 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <fmt/format.h>
+#include <taskbench/tasks/cpu/sort.h>
+#include <taskbench/tasks/disk/external_sort.h>
+#include <taskbench/utils/data_generator.h>
+#include <taskbench/utils/timer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace taskbench::disk {
+
+using File = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+/**
+ * @brief Open path unbuffered (all reads and writes are of whole blocks)
+ */
+static File open_file(const std::filesystem::path& path, const char* mode) {
+  std::FILE* file = std::fopen(path.string().c_str(), mode);
+  if (file == nullptr) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+  std::setvbuf(file, nullptr, _IONBF, 0);
+  return {file, &std::fclose};
+}
+
+static size_t read_block(std::FILE* file, uint64_t* data, size_t size) {
+  size_t read = std::fread(data, sizeof(uint64_t), size, file);
+  if (read < size && std::ferror(file) != 0) {
+    throw std::runtime_error("Cannot read from file");
+  }
+  return read;
+}
+
+static void write_block(std::FILE* file, const uint64_t* data, size_t size) {
+  if (std::fwrite(data, sizeof(uint64_t), size, file) != size) {
+    throw std::runtime_error("Cannot write to file");
+  }
+}
+
+/**
+ * @brief Lease a data buffer from the global utils::BufferPool, so that it counts against the memory budget of the pool
+ */
+static utils::Buffer<uint64_t> lease(size_t size, utils::PageMode mode) {
+  return {size, mode, utils::BufferPool::global()};
+}
+
+/**
+ * @brief Sequential reader of a run: the next block is read asynchronously while the current one is consumed
+ */
+class RunReader {
+ public:
+  RunReader(const std::filesystem::path& path, size_t block_size, utils::PageMode mode)
+      : _file(open_file(path, "rb")), _blocks{lease(block_size, mode), lease(block_size, mode)} {
+    _prefetch();
+    _next();
+  }
+
+  [[nodiscard]] bool empty() const { return _size == 0; }
+  [[nodiscard]] uint64_t front() const { return _blocks[_current][_pos]; }
+
+  void pop() {
+    if (++_pos == _size) {
+      _next();
+    }
+  }
+
+ private:
+  void _prefetch() {
+    auto& block = _blocks[1 - _current];
+    _pending = std::async(std::launch::async,
+                          [this, &block] { return read_block(_file.get(), block.data(), block.size()); });
+  }
+
+  void _next() {
+    _size = _pending.get();
+    _current = 1 - _current;
+    _pos = 0;
+    if (_size > 0) {
+      _prefetch();
+    }
+  }
+
+  File _file;
+  std::array<utils::Buffer<uint64_t>, 2> _blocks;
+  size_t _current{1};
+  size_t _pos{0};
+  size_t _size{0};
+  // declared last: a pending read finishes before the blocks are destroyed
+  std::future<size_t> _pending;
+};
+
+/**
+ * @brief Sequential writer: a full block is written asynchronously while the other one is filled
+ */
+class RunWriter {
+ public:
+  RunWriter(const std::filesystem::path& path, size_t block_size, utils::PageMode mode)
+      : _file(open_file(path, "wb")), _blocks{lease(block_size, mode), lease(block_size, mode)} {}
+
+  void push(uint64_t value) {
+    _blocks[_current][_pos++] = value;
+    if (_pos == _blocks[_current].size()) {
+      _flush();
+    }
+  }
+
+  /**
+   * @brief Write the remaining elements and wait for all writes
+   */
+  void close() {
+    _flush();
+    _pending.get();
+  }
+
+ private:
+  void _flush() {
+    if (_pending.valid()) {
+      _pending.get();
+    }
+    auto& block = _blocks[_current];
+    _pending = std::async(std::launch::async,
+                          [this, &block, size = _pos] { write_block(_file.get(), block.data(), size); });
+    _current = 1 - _current;
+    _pos = 0;
+  }
+
+  File _file;
+  std::array<utils::Buffer<uint64_t>, 2> _blocks;
+  size_t _current{0};
+  size_t _pos{0};
+  std::future<void> _pending;
+};
+
+// _____________________________________________________________________________________________________________________
+TemporaryFiles::TemporaryFiles(TemporaryFiles&& other) noexcept : _paths(std::exchange(other._paths, {})) {}
+
+// _____________________________________________________________________________________________________________________
+TemporaryFiles& TemporaryFiles::operator=(TemporaryFiles&& other) noexcept {
+  if (this != &other) {
+    clear();
+    _paths = std::exchange(other._paths, {});
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________________________________________________
+TemporaryFiles::~TemporaryFiles() { clear(); }
+
+// _____________________________________________________________________________________________________________________
+const std::filesystem::path& TemporaryFiles::add(std::filesystem::path path) {
+  _paths.push_back(std::move(path));
+  return _paths.back();
+}
+
+// _____________________________________________________________________________________________________________________
+void TemporaryFiles::clear() noexcept {
+  for (const auto& path : _paths) {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+  }
+  _paths.clear();
+}
+
+// _____________________________________________________________________________________________________________________
+const std::vector<std::filesystem::path>& TemporaryFiles::paths() const { return _paths; }
+
+// _____________________________________________________________________________________________________________________
+size_t TemporaryFiles::size() const { return _paths.size(); }
+
+// _____________________________________________________________________________________________________________________
+ExternalSort::ExternalSort(std::filesystem::path directory, size_t memory_budget, utils::WorkerPool& pool,
+                           utils::PageMode page_mode)
+    : _directory(std::move(directory)), _memory_budget(memory_budget), _pool(pool), _page_mode(page_mode) {
+  if (_memory_budget < 8 * min_block_size * sizeof(uint64_t)) {
+    throw std::runtime_error("Memory budget of the external sort is too small");
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+ExternalSortStats ExternalSort::operator()(const std::filesystem::path& input, const std::filesystem::path& output) {
+  ExternalSortStats stats;
+  utils::Timer timer;
+  timer.start();
+  auto runs = _generate_runs(input, stats);
+  stats.run_generation = timer.stop();
+  stats.num_runs = runs.size();
+
+  // every run and the output are double buffered
+  size_t max_fan_in = _memory_budget / (2 * min_block_size * sizeof(uint64_t)) - 1;
+  timer.start();
+  for (size_t pass = 1; runs.size() > max_fan_in; ++pass) {
+    // the merged runs are owned before they are written: a failing merge removes its partial output as well
+    TemporaryFiles merged;
+    for (size_t i = 0; i < runs.size(); i += max_fan_in) {
+      size_t end = std::min(i + max_fan_in, runs.size());
+      std::vector<std::filesystem::path> group(runs.paths().begin() + static_cast<std::ptrdiff_t>(i),
+                                               runs.paths().begin() + static_cast<std::ptrdiff_t>(end));
+      _merge(group, merged.add(_run_path(pass, merged.size())));
+      for (const auto& run : group) {
+        std::filesystem::remove(run);
+      }
+    }
+    runs = std::move(merged);
+    ++stats.num_merge_passes;
+  }
+  _merge(runs.paths(), output);
+  runs.clear();
+  ++stats.num_merge_passes;
+  stats.merge = timer.stop();
+  return stats;
+}
+
+// _____________________________________________________________________________________________________________________
+TemporaryFiles ExternalSort::_generate_runs(const std::filesystem::path& input, ExternalSortStats& stats) {
+  // the chunk being read, the chunk being sorted, the run being written and the scratch memory of the sort
+  size_t run_size = _memory_budget / (4 * sizeof(uint64_t));
+  std::array<utils::Buffer<uint64_t>, 3> chunks;
+  for (auto& chunk : chunks) {
+    chunk = lease(run_size, _page_mode);
+  }
+  auto buffer = lease(run_size, _page_mode);
+  stats.page_mode = chunks[0].page_mode();
+
+  auto file = open_file(input, "rb");
+  // declared before the futures: on an exception, pending reads and writes finish before the runs are removed
+  TemporaryFiles runs;
+  auto read = [&](size_t chunk) {
+    return std::async(std::launch::async,
+                      [&, chunk] { return read_block(file.get(), chunks[chunk].data(), chunks[chunk].size()); });
+  };
+  std::future<size_t> pending_read = read(0);
+  std::future<void> pending_write;
+  for (size_t i = 0;; ++i) {
+    auto& chunk = chunks[i % chunks.size()];
+    size_t size = pending_read.get();
+    if (size == 0) {
+      break;
+    }
+    // the chunk of run i - 2 is free since its write was awaited before writing run i - 1
+    pending_read = read((i + 1) % chunks.size());
+
+    cpu::sort::SampleSort<uint64_t> sorter(chunk.data(), size, buffer.data(), _pool.size());
+    _pool.run([&](size_t thread_id) { sorter(thread_id); });
+
+    if (pending_write.valid()) {
+      pending_write.get();
+    }
+    pending_write = std::async(std::launch::async, [&chunk, size, path = runs.add(_run_path(0, i))] {
+      auto run = open_file(path, "wb");
+      write_block(run.get(), chunk.data(), size);
+    });
+  }
+  if (pending_write.valid()) {
+    pending_write.get();
+  }
+  return runs;
+}
+
+// _____________________________________________________________________________________________________________________
+void ExternalSort::_merge(const std::vector<std::filesystem::path>& runs, const std::filesystem::path& output) const {
+  size_t block_size = _memory_budget / (2 * (runs.size() + 1) * sizeof(uint64_t));
+  std::vector<std::unique_ptr<RunReader>> readers;
+  readers.reserve(runs.size());
+  using Entry = std::pair<uint64_t, size_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+  for (const auto& run : runs) {
+    readers.push_back(std::make_unique<RunReader>(run, block_size, _page_mode));
+    if (!readers.back()->empty()) {
+      heap.emplace(readers.back()->front(), readers.size() - 1);
+    }
+  }
+
+  RunWriter writer(output, block_size, _page_mode);
+  while (!heap.empty()) {
+    auto [value, run] = heap.top();
+    heap.pop();
+    writer.push(value);
+    auto& reader = *readers[run];
+    reader.pop();
+    if (!reader.empty()) {
+      heap.emplace(reader.front(), run);
+    }
+  }
+  writer.close();
+}
+
+// _____________________________________________________________________________________________________________________
+std::filesystem::path ExternalSort::_run_path(size_t pass, size_t run) const {
+  return _directory / fmt::format("taskbench_external_sort_{}_{}_{}.tmp", reinterpret_cast<uintptr_t>(this), pass, run);
+}
+
+// _____________________________________________________________________________________________________________________
+void ExternalSort::generate(const std::filesystem::path& path, size_t size, unsigned seed) {
+  auto file = open_file(path, "wb");
+  uint64_t key = utils::rng::key(seed);
+  auto block = lease(std::min<size_t>(size, 1 << 22), utils::PageMode::DEFAULT);
+  for (size_t offset = 0; offset < size; offset += block.size()) {
+    size_t n = std::min(block.size(), size - offset);
+    utils::rng::parallel_for(n, [&](size_t begin, size_t end) {
+      utils::rng::fill(block.data() + begin, end - begin, key, offset + begin, 0);
+    });
+    write_block(file.get(), block.data(), n);
+  }
+}
+
+}  // namespace taskbench::disk
\ No newline at end of file
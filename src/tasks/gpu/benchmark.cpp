@@ -32,8 +32,6 @@ void Benchmark::run_all(seconds runtime) {
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_mmul(seconds runtime) {
   try {
-    utils::Timer timer;
-
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  Matrix Multiplication Benchmarks:\n");
       std::cout << std::flush;
@@ -55,18 +53,8 @@ void Benchmark::run_mmul(seconds runtime) {
       std::fill_n(mat2.data(), mat2.size(), 1.23457f);
       std::fill_n(result.data(), result.size(), 0.0f);
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
-        timer.start();
-        mmul::matrix_multiply(mat1, mat2, result, 2048);
-        auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_o_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+      _measure(name, runtime, [&] { mmul::matrix_multiply(mat1, mat2, result, 2048); });
+      _print_o_per_second(_benchmark_result.at(name));
     }
 
     if (_verbosity != VERBOSITY::OFF) {
@@ -80,8 +68,6 @@ void Benchmark::run_mmul(seconds runtime) {
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_memory(seconds runtime) {
   try {
-    utils::Timer timer;
-
     if (_verbosity != VERBOSITY::OFF) {
       fmt::print(fg(fmt::color::aqua) | fmt::emphasis::bold, "  Memory Benchmarks:\n");
       std::cout << std::flush;
@@ -101,18 +87,8 @@ void Benchmark::run_memory(seconds runtime) {
 
       auto setup = memory::setup_memory_write(data);
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
-        timer.start();
-        setup.kernel->run();
-        auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_gib_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+      _measure(name, runtime, [&] { setup.kernel->run(); });
+      _print_gib_per_second(_benchmark_result.at(name));
     }
 
     {  // GPU memory read
@@ -125,18 +101,8 @@ void Benchmark::run_memory(seconds runtime) {
 
       auto setup = memory::setup_memory_read(data);
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
-        timer.start();
-        setup.kernel->run();
-        auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_gib_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+      _measure(name, runtime, [&] { setup.kernel->run(); });
+      _print_gib_per_second(_benchmark_result.at(name));
     }
 
     if (_verbosity != VERBOSITY::OFF) {
@@ -169,19 +135,14 @@ void Benchmark::run_transfer_speed(seconds runtime) {
         std::cout << std::flush;
       }
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
+      _measure(name, runtime, [&] {
         auto setup = memory::setup_memory(data);
         timer.start();
         setup.buffer.write_to_device();
         auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_gib_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+        return bm_time;
+      });
+      _print_gib_per_second(_benchmark_result.at(name));
     }
 
     {  // read data from OpenCL device
@@ -192,20 +153,15 @@ void Benchmark::run_transfer_speed(seconds runtime) {
         std::cout << std::flush;
       }
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
+      _measure(name, runtime, [&] {
         auto setup = memory::setup_memory(data);
         setup.buffer.write_to_device();
         timer.start();
         setup.buffer.read_from_device();
         auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_gib_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+        return bm_time;
+      });
+      _print_gib_per_second(_benchmark_result.at(name));
     }
 
     if (_verbosity != VERBOSITY::OFF) {
@@ -240,19 +196,14 @@ void Benchmark::run_synthetic(seconds runtime) {
 
       _register_benchmark(0, static_cast<uint64_t>(2048ull * size), name);
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
+      _measure(name, runtime, [&] {
         timer.start();
         setup.kernel->run();
         auto bm_time = timer.stop();
         setup.buffer.read_from_device();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_o_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+        return bm_time;
+      });
+      _print_o_per_second(_benchmark_result.at(name));
     }
 
     {  // computing GPU float operations
@@ -269,18 +220,8 @@ void Benchmark::run_synthetic(seconds runtime) {
 
       _register_benchmark(0, static_cast<uint64_t>(2048ull * size), name);
 
-      utils::Timer rt_timer;
-      rt_timer.start();
-      auto rt = runtime;
-      while (rt.count() > 0) {
-        timer.start();
-        setup.kernel->run();
-        auto bm_time = timer.stop();
-        _add_result(name, bm_time);
-        _print_runtime(_benchmark_result.at(name));
-        _print_o_per_second(_benchmark_result.at(name));
-        rt -= rt_timer.round();
-      }
+      _measure(name, runtime, [&] { setup.kernel->run(); });
+      _print_o_per_second(_benchmark_result.at(name));
     }
 
     if (_verbosity != VERBOSITY::OFF) {
@@ -7,28 +7,61 @@
 
 #include <fmt/color.h>
 #include <taskbench/tasks/ram/benchmark.h>
+#include <taskbench/tasks/ram/latency.h>
+#include <taskbench/tasks/ram/random.h>
 #include <taskbench/tasks/ram/read.h>
 #include <taskbench/tasks/ram/read_write.h>
+#include <taskbench/tasks/ram/stream.h>
+#include <taskbench/tasks/ram/strided.h>
 #include <taskbench/tasks/ram/write.h>
 #include <taskbench/utils/data_generator.h>
 #include <taskbench/utils/statistics.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
 #include <thread>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
 namespace taskbench::ram {
 
-template <typename T>
-struct SmartBuffer {
-  explicit SmartBuffer(size_t s) : size(s) { data = new T[size]; }
-  ~SmartBuffer() { delete[] data; }
-  void resize(size_t s) {
-    delete[] data;
-    data = new T[size];
-    size = s;
+/**
+ * @brief Physical memory of the machine in bytes (0 if it can not be determined)
+ */
+static uint64_t physical_memory() {
+#if defined(__unix__) || defined(__APPLE__)
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long page_size = sysconf(_SC_PAGE_SIZE);
+  if (pages > 0 && page_size > 0) {
+    return static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size);
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Sizes from min_size to max_size on a log scale with points_per_octave sizes per doubling, rounded down to
+ *  whole cache lines
+ */
+static std::vector<uint64_t> log_sizes(uint64_t min_size, uint64_t max_size, size_t points_per_octave) {
+  std::vector<uint64_t> sizes;
+  for (size_t i = 0;; ++i) {
+    double exponent = static_cast<double>(i) / static_cast<double>(points_per_octave);
+    auto size = static_cast<uint64_t>(static_cast<double>(min_size) * std::exp2(exponent)) & ~uint64_t{63};
+    if (size > max_size) {
+      break;
+    }
+    if (size > 0 && (sizes.empty() || sizes.back() != size)) {
+      sizes.push_back(size);
+    }
   }
-  T* data;
-  size_t size;
-};
+  return sizes;
+}
 
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_all(seconds runtime) {
@@ -36,14 +69,50 @@ void Benchmark::run_all(seconds runtime) {
     fmt::print(fg(fmt::color::beige) | fmt::emphasis::bold, "RAM Benchmarks:\n");
     std::cout << std::flush;
   }
-  run_read(runtime);
-  run_write(runtime);
-  run_read_write(runtime);
+  _run_within_budget("RAM Read", [&] { run_read(runtime); });
+  _run_within_budget("RAM Write", [&] { run_write(runtime); });
+  _run_within_budget("RAM Read/Write", [&] { run_read_write(runtime); });
+  _run_within_budget("RAM STREAM", [&] { run_stream(runtime); });
+  _run_within_budget("RAM Random Access", [&] { run_random_access(runtime); });
+  _run_within_budget("RAM Strided", [&] { run_strided(runtime); });
+  _run_within_budget("RAM Latency", [&] { run_latency(runtime); });
+  _run_within_budget("RAM Loaded Latency", [&] { run_loaded_latency(runtime); });
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_working_set_sweep(uint64_t min_size, uint64_t max_size, size_t points_per_octave) {
+  _sweep_min_size = min_size;
+  _sweep_max_size = max_size;
+  _sweep_points_per_octave = std::max<size_t>(points_per_octave, 1);
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::set_huge_pages(bool enabled) { _huge_pages = enabled; }
+
+// _____________________________________________________________________________________________________________________
+std::vector<uint64_t> Benchmark::_working_set_sizes() const {
+  if (_sweep_min_size == 0) {
+    return {};
+  }
+  uint64_t max_size = _sweep_max_size;
+  if (auto memory = physical_memory(); memory > 0) {
+    max_size = std::min(max_size, memory / 2);
+  }
+  return log_sizes(_sweep_min_size, max_size, _sweep_points_per_octave);
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Benchmark::_sweep_passes(uint64_t working_set) {
+  // small working sets are traversed repeatedly within a single run so that the synchronization of the workers does
+  // not dominate the measured time
+  return std::max<uint64_t>(1, S_64_MiB / working_set);
 }
 
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_read(seconds runtime) {
-  utils::Timer timer;
+  size_t size = _array_size<char>(_buffer_size);
+  auto data = _allocate<char>(size);
+  std::fill(data.begin(), data.end(), 34);
 
   {  // read
     std::string name("Read");
@@ -53,44 +122,66 @@ void Benchmark::run_read(seconds runtime) {
       std::cout << std::flush;
     }
 
-    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
-    size_t size = _array_size<char>(_buffer_size);
-    std::vector<char> data(size);
-    std::fill_n(data.data(), data.size(), 34);
-    auto seq_partition_size = static_cast<size_t>(_buffer_size / num_threads);
-    std::vector<std::thread> threads(num_threads);
-
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      size_t pos = 0;
-      timer.start();
-      for (auto& t : threads) {
-        t = std::thread(read::sequential, data.data() + pos, seq_partition_size);
-        pos += seq_partition_size;
-      }
-      for (auto& t : threads) {
-        if (t.joinable()) {
-          t.join();
-        }
-      }
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
-      _print_runtime(_benchmark_result.at(name));
-      _print_gib_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+    if (auto sweep_sizes = _working_set_sizes(); !sweep_sizes.empty()) {
+      auto sweep_data = _allocate<char>(sweep_sizes.back());
+      std::fill(sweep_data.begin(), sweep_data.end(), 34);
+      size_t sweep_size = 0;
+      size_t passes = 1;
+      _measure_parallel_sweep(
+          name, runtime, sweep_threads, "working_set", sweep_sizes,
+          [&](uint64_t working_set) {
+            sweep_size = _array_size<char>(working_set);
+            passes = _sweep_passes(working_set);
+            return working_set * passes;
+          },
+          [&](size_t thread_id, size_t num_threads) {
+            auto [begin, end] = utils::partition(sweep_size, thread_id, num_threads);
+            for (size_t pass = 0; pass < passes; ++pass) {
+              read::sequential(sweep_data.data() + begin, end - begin);
+            }
+          });
+      _benchmark_result.at(name).set_parameter("sweep_threads", sweep_threads);
     }
+
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(size, thread_id, num_threads);
+      read::sequential(data.data() + begin, end - begin);
+    });
+    _benchmark_result.at(name).set_parameter("kernel", to_string(read::kernels().back()));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
   }
 
   if (_verbosity != VERBOSITY::OFF) {
     std::cout << std::endl;
   }
+
+  for (auto kernel : read::kernels()) {  // read with each kernel
+    std::string name(fmt::format("Read ({})", to_string(kernel)));
+    _register_benchmark(_buffer_size, 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    auto function = read::get(kernel);
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(size, thread_id, num_threads);
+      function(data.data() + begin, end - begin);
+    });
+    _benchmark_result.at(name).set_parameter("kernel", to_string(kernel));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
 }
 
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_write(seconds runtime) {
-  utils::Timer timer;
+  size_t size = _array_size<char>(_buffer_size);
 
   {  // write
     std::string name("Write");
@@ -100,50 +191,83 @@ void Benchmark::run_write(seconds runtime) {
       std::cout << std::flush;
     }
 
-    size_t size = _array_size<int>(_buffer_size);
-    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
-    auto partition_size = size / num_threads;
-    std::vector<std::thread> threads(num_threads);
-
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      SmartBuffer<int> data(size);
-      size_t pos = 0;
-      timer.start();
-      for (auto& t : threads) {
-        t = std::thread(write::sequential, data.data + pos, partition_size, 5);
-        pos += partition_size;
-      }
-      for (auto& t : threads) {
-        if (t.joinable()) {
-          t.join();
-        }
-      }
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
+    if (auto sweep_sizes = _working_set_sizes(); !sweep_sizes.empty()) {
+      auto sweep_data = _allocate<char>(sweep_sizes.back());
+      size_t sweep_size = 0;
+      size_t passes = 1;
+      _measure_parallel_sweep(
+          name, runtime, sweep_threads, "working_set", sweep_sizes,
+          [&](uint64_t working_set) {
+            sweep_size = _array_size<char>(working_set);
+            passes = _sweep_passes(working_set);
+            return working_set * passes;
+          },
+          [&](size_t thread_id, size_t num_threads) {
+            auto [begin, end] = utils::partition(sweep_size, thread_id, num_threads);
+            for (size_t pass = 0; pass < passes; ++pass) {
+              write::sequential(sweep_data.data() + begin, end - begin, static_cast<char>(pass));
+            }
+          });
+      _benchmark_result.at(name).set_parameter("sweep_threads", sweep_threads);
+    }
 
-      // This statement will always be true and prevents the compiler from optimizing things away that are needed
-      if (data.data[0] != data.data[partition_size + 1]) {
-        std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
-                     "compiler from optimizing things away...";
-      }
+    utils::Buffer<char> data;
 
-      _print_runtime(_benchmark_result.at(name));
-      _print_gib_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+    // every run writes to freshly mapped pages, the previous buffer is unmapped first
+    _measure_parallel(
+        name, runtime, _num_threads,
+        [&](size_t thread_id, size_t num_threads) {
+          auto [begin, end] = utils::partition(size, thread_id, num_threads);
+          write::sequential(data.data() + begin, end - begin, 5);
+        },
+        [&](size_t) {
+          data = utils::Buffer<char>();
+          data = _allocate<char>(size, true);
+        });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+
+    // This statement will always be true and prevents the compiler from optimizing things away that are needed
+    if (data[0] != data[size - 1]) {
+      std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                   "compiler from optimizing things away...";
     }
+    _print_gib_per_second(_benchmark_result.at(name));
   }
 
   if (_verbosity != VERBOSITY::OFF) {
     std::cout << std::endl;
   }
+
+  // the kernels write to an already mapped buffer so that regular and non-temporal stores can be compared without the
+  // cost of page faults
+  auto data = _allocate<char>(size);
+  std::fill(data.begin(), data.end(), 0);
+  for (auto kernel : write::kernels()) {  // write with each kernel
+    std::string name(fmt::format("Write ({})", to_string(kernel)));
+    _register_benchmark(_buffer_size, 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40}", name);
+      std::cout << std::flush;
+    }
+
+    auto function = write::get(kernel);
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(size, thread_id, num_threads);
+      function(data.data() + begin, end - begin, 5);
+    });
+    _benchmark_result.at(name).set_parameter("kernel", to_string(kernel));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
 }
 
 // _____________________________________________________________________________________________________________________
 void Benchmark::run_read_write(seconds runtime) {
-  utils::Timer timer;
+  size_t size = _array_size<char>(_buffer_size);
 
   {  // multi thread
     std::string name("Mixed");
@@ -153,46 +277,411 @@ void Benchmark::run_read_write(seconds runtime) {
       std::cout << std::flush;
     }
 
-    size_t size = _array_size<int>(_buffer_size);
-    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
-    auto partition_size = size / num_threads;
-    SmartBuffer<int> data(size);
-    std::vector<std::thread> threads(num_threads);
-
-    utils::Timer rt_timer;
-    rt_timer.start();
-    auto rt = runtime;
-    while (rt.count() > 0) {
-      SmartBuffer<int> dst(size);
-      std::memset(data.data, 4, size);
-      size_t pos = 0;
-      timer.start();
-      for (auto& t : threads) {
-        t = std::thread(read_write::sequential, data.data + pos, dst.data + pos, partition_size);
-        pos += partition_size;
-      }
-      for (auto& t : threads) {
-        if (t.joinable()) {
-          t.join();
-        }
-      }
-      auto bm_time = timer.stop();
-      _add_result(name, bm_time);
+    if (auto sweep_sizes = _working_set_sizes(); !sweep_sizes.empty()) {
+      // the working set consists of the source and the destination buffer
+      auto sweep_data = _allocate<char>(sweep_sizes.back() / 2);
+      auto sweep_dst = _allocate<char>(sweep_data.size());
+      std::fill(sweep_data.begin(), sweep_data.end(), 4);
+      std::fill(sweep_dst.begin(), sweep_dst.end(), 0);
+      size_t sweep_size = 0;
+      size_t passes = 1;
+      _measure_parallel_sweep(
+          name, runtime, sweep_threads, "working_set", sweep_sizes,
+          [&](uint64_t working_set) {
+            sweep_size = _array_size<char>(working_set / 2);
+            passes = _sweep_passes(working_set);
+            return working_set / 2 * passes;
+          },
+          [&](size_t thread_id, size_t num_threads) {
+            auto [begin, end] = utils::partition(sweep_size, thread_id, num_threads);
+            for (size_t pass = 0; pass < passes; ++pass) {
+              read_write::sequential(sweep_data.data() + begin, sweep_dst.data() + begin, end - begin);
+            }
+          });
+      _benchmark_result.at(name).set_parameter("sweep_threads", sweep_threads);
+    }
 
-      if (data.data[partition_size] != dst.data[partition_size]) {
-        std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
-                     "compiler from optimizing things away...";
-      }
+    auto data = _allocate<char>(size);
+    utils::Buffer<char> dst;
+
+    // every run copies to freshly mapped pages, the previous destination is unmapped first
+    _measure_parallel(
+        name, runtime, _num_threads,
+        [&](size_t thread_id, size_t num_threads) {
+          auto [begin, end] = utils::partition(size, thread_id, num_threads);
+          read_write::sequential(data.data() + begin, dst.data() + begin, end - begin);
+        },
+        [&](size_t) {
+          dst = utils::Buffer<char>();
+          dst = _allocate<char>(size, true);
+          std::memset(data.data(), 4, size);
+        });
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
 
-      _print_runtime(_benchmark_result.at(name));
-      _print_gib_per_second(_benchmark_result.at(name));
-      rt -= rt_timer.round();
+    if (data[size - 1] != dst[size - 1]) {
+      std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                   "compiler from optimizing things away...";
     }
+    _print_gib_per_second(_benchmark_result.at(name));
   }
 
   if (_verbosity != VERBOSITY::OFF) {
     std::cout << std::endl;
   }
+
+  auto data = _allocate<char>(size);
+  auto dst = _allocate<char>(size);
+  std::fill(data.begin(), data.end(), 4);
+  std::fill(dst.begin(), dst.end(), 0);
+  for (auto kernel : read_write::kernels()) {  // copy with each kernel
+    std::string name(fmt::format("Mixed ({})", to_string(kernel)));
+    _register_benchmark(_buffer_size, 0, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+      std::cout << std::flush;
+    }
+
+    auto function = read_write::get(kernel);
+    _measure_parallel(name, runtime, _num_threads, [&](size_t thread_id, size_t num_threads) {
+      auto [begin, end] = utils::partition(size, thread_id, num_threads);
+      function(data.data() + begin, dst.data() + begin, end - begin);
+    });
+    _benchmark_result.at(name).set_parameter("kernel", to_string(kernel));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_stream(seconds runtime) {
+  const double scalar = 3.0;
+  size_t size = _array_size<double>(_buffer_size / 4);
+  // freshly mapped on purpose: the pages are mapped by the first thread writing to them
+  auto a = _allocate<double>(size, true);
+  auto b = _allocate<double>(size, true);
+  auto c = _allocate<double>(size, true);
+
+  // first touch by the workers that process the partitions later on (lands on their NUMA nodes)
+  _worker_pool(_num_threads).run([&](size_t thread_id) {
+    auto [begin, end] = utils::partition(size, thread_id, _num_threads);
+    std::fill(a.data() + begin, a.data() + end, 1.0);
+    std::fill(b.data() + begin, b.data() + end, 2.0);
+    std::fill(c.data() + begin, c.data() + end, 0.0);
+  });
+
+  auto measure = [&](const std::string& name, size_t num_arrays, const ParallelJob& job) {
+    _register_benchmark(num_arrays * size * sizeof(double), size, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+      std::cout << std::flush;
+    }
+    _measure_parallel(name, runtime, _num_threads, job);
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(a.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  };
+
+  measure("STREAM Copy", 2, [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(size, thread_id, num_threads);
+    stream::copy(a.data() + begin, c.data() + begin, end - begin);
+  });
+  measure("STREAM Scale", 2, [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(size, thread_id, num_threads);
+    stream::scale(b.data() + begin, c.data() + begin, scalar, end - begin);
+  });
+  measure("STREAM Add", 3, [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(size, thread_id, num_threads);
+    stream::add(a.data() + begin, b.data() + begin, c.data() + begin, end - begin);
+  });
+  measure("STREAM Triad", 3, [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(size, thread_id, num_threads);
+    stream::triad(a.data() + begin, b.data() + begin, c.data() + begin, scalar, end - begin);
+  });
+
+  // every kernel is idempotent: a = 1 -> c = 1 -> b = 3 -> c = 4 -> a = 15
+  if (a[size - 1] != 15.0 || b[size - 1] != 3.0 || c[size - 1] != 4.0) {
+    std::cerr << "STREAM benchmark failed: the arrays do not hold the expected values." << std::endl;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_random_access(seconds runtime) {
+  // accesses per run of the workers
+  const size_t num_accesses = S_4_MiB;
+  auto lines = _allocate<random::Line>(_buffer_size / sizeof(random::Line));
+  std::fill(lines.begin(), lines.end(), random::Line{{1, 2, 3, 4, 5, 6, 7, 8}});
+  auto* words = reinterpret_cast<uint64_t*>(lines.data());
+  // the two index sets use their own seeds: with a shared seed line_indices[i] would just be word_indices[i] / 8 and
+  // the word and line benchmarks would hit the same lines in the same order
+  const unsigned word_seed = 42;
+  const unsigned line_seed = word_seed + 1;
+  auto word_indices = _allocate<uint64_t>(num_accesses);
+  auto line_indices = _allocate<uint64_t>(num_accesses);
+  utils::DataGenerator::fill<uint64_t>(word_indices.data(), num_accesses, word_seed, 0, lines.size() * 8 - 1);
+  utils::DataGenerator::fill<uint64_t>(line_indices.data(), num_accesses, line_seed, 0, lines.size() - 1);
+  std::atomic<uint64_t> res{0};
+
+  auto measure = [&](const std::string& name, size_t access_size, const ParallelJob& job) {
+    _register_benchmark(num_accesses * access_size, num_accesses, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+      std::cout << std::flush;
+    }
+    _measure_parallel(name, runtime, _num_threads, job);
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(lines.page_mode()));
+    _print_gib_per_second(_benchmark_result.at(name));
+    _print_o_per_second(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  };
+
+  measure("Random Read (8 B)", sizeof(uint64_t), [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(num_accesses, thread_id, num_threads);
+    res.fetch_xor(random::read(words, word_indices.data() + begin, end - begin), std::memory_order_relaxed);
+  });
+  measure("Random Read (64 B)", sizeof(random::Line), [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(num_accesses, thread_id, num_threads);
+    res.fetch_xor(random::read_lines(lines.data(), line_indices.data() + begin, end - begin),
+                  std::memory_order_relaxed);
+  });
+  measure("Random Write (8 B)", sizeof(uint64_t), [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(num_accesses, thread_id, num_threads);
+    random::write(words, word_indices.data() + begin, end - begin, thread_id);
+  });
+  measure("Random Write (64 B)", sizeof(random::Line), [&](size_t thread_id, size_t num_threads) {
+    auto [begin, end] = utils::partition(num_accesses, thread_id, num_threads);
+    random::write_lines(lines.data(), line_indices.data() + begin, end - begin, thread_id);
+  });
+
+  if (res.load() == 0 && words[0] == 0xffffffffffffffff) {
+    std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                 "compiler from optimizing things away...";
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_strided(seconds runtime) {
+  std::string name("Strided Read");
+  const uint64_t headline_stride = 64;
+  size_t size = _array_size<char>(_buffer_size);
+  auto data = _allocate<char>(size);
+  std::fill(data.begin(), data.end(), 34);
+  std::atomic<uint64_t> res{0};
+
+  _register_benchmark(size / headline_stride * sizeof(uint64_t), size / headline_stride, name);
+  if (_verbosity != VERBOSITY::OFF) {
+    fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+    std::cout << std::flush;
+  }
+
+  size_t stride = headline_stride;
+  auto job = [&](size_t thread_id, size_t num_threads) {
+    // partitions start at multiples of the stride
+    auto [begin, end] = utils::partition(size / stride, thread_id, num_threads);
+    res.fetch_xor(strided::read(data.data() + begin * stride, (end - begin) * stride, stride),
+                  std::memory_order_relaxed);
+  };
+
+  _measure_parallel_sweep(
+      name, runtime, _num_threads, "stride", {8, 16, 32, 64, 128, 256, 512, S_1_KiB, S_2_KiB, S_4_KiB},
+      [&](uint64_t s) {
+        stride = s;
+        return size / stride * sizeof(uint64_t);
+      },
+      job);
+
+  stride = headline_stride;
+  _measure_parallel(name, runtime, _num_threads, job);
+  _benchmark_result.at(name).set_parameter("stride", headline_stride);
+  _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+  _print_gib_per_second(_benchmark_result.at(name));
+  _print_o_per_second(_benchmark_result.at(name));
+
+  if (res.load() == 1) {
+    std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                 "compiler from optimizing things away...";
+  }
+  if (_verbosity != VERBOSITY::OFF) {
+    std::cout << std::endl;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_latency(seconds runtime) {
+  auto sizes = _working_set_sizes();
+  if (sizes.empty()) {
+    sizes = log_sizes(S_4_KiB, _buffer_size, 1);
+  }
+  uint64_t max_size = std::max<uint64_t>(sizes.back(), _buffer_size);
+  // loads per run of the probe, long enough to amortize the synchronization of the worker pool
+  size_t num_loads = S_1_MiB;
+
+  for (bool huge_pages : {false, true}) {
+    if (huge_pages && !_huge_pages) {
+      break;
+    }
+    std::string name(huge_pages ? "Latency (huge pages)" : "Latency");
+    _register_benchmark(num_loads * sizeof(latency::Node), num_loads, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+      std::cout << std::flush;
+    }
+
+    // leased from the pool like every benchmark buffer: it is checked against the budget and reuses (or unmaps) the
+    // buffer of the previous iteration instead of being mapped next to it
+    auto nodes = huge_pages ? utils::Buffer<latency::Node>(max_size / sizeof(latency::Node), utils::PageMode::THP,
+                                                           utils::BufferPool::global())
+                            : _allocate<latency::Node>(max_size / sizeof(latency::Node));
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(nodes.page_mode()));
+    const latency::Node* node = nullptr;
+    auto probe = [&](size_t, size_t) { node = latency::chase(node, num_loads); };
+
+    _measure_parallel_sweep(
+        name, runtime, 1, "working_set", sizes,
+        [&](uint64_t working_set) {
+          node = latency::build_chain(nodes.data(), working_set / sizeof(latency::Node), 42);
+          return num_loads * sizeof(latency::Node);
+        },
+        probe);
+
+    node = latency::build_chain(nodes.data(), _buffer_size / sizeof(latency::Node), 42);
+    _measure_parallel(name, runtime, 1, probe);
+
+    if (node == nullptr) {
+      std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                   "compiler from optimizing things away...";
+    }
+    _print_latency(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void Benchmark::run_loaded_latency(seconds runtime) {
+  // delays of the load threads after each chunk in ns, from a saturated memory bus to almost idle
+  const std::vector<uint64_t> delays{0, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000};
+  const size_t chunk_size = S_64_KiB;
+  const size_t num_loads = S_256_KiB;
+  // the probe runs on thread 0, all other threads generate load
+  size_t pool_size = std::max<size_t>(_num_threads, 2);
+
+  // the probe chain is large enough to miss all caches
+  auto nodes = _allocate<latency::Node>(_buffer_size / 4 / sizeof(latency::Node));
+  const latency::Node* node = latency::build_chain(nodes.data(), nodes.size(), 42);
+
+  for (bool write_load : {false, true}) {
+    std::string name(write_load ? "Loaded Latency (write)" : "Loaded Latency (read)");
+    _register_benchmark(num_loads * sizeof(latency::Node), num_loads, name);
+    if (_verbosity != VERBOSITY::OFF) {
+      fmt::print(fg(fmt::color::azure), "    {:40} ", name);
+      std::cout << std::flush;
+    }
+
+    auto data = _allocate<char>(_array_size<char>(_buffer_size));
+    std::fill(data.begin(), data.end(), 34);
+    std::chrono::nanoseconds delay(0);
+    std::atomic<bool> probe_done{false};
+    // probe time and loaded bytes of the current run and of the runs since the last recorded sample
+    seconds run_probe_time(0);
+    std::atomic<uint64_t> run_bytes{0};
+    bool run_pending = false;
+    std::vector<std::pair<seconds, uint64_t>> runs;
+    // totals of the runs of the recorded samples of the current sweep point
+    seconds probe_time(0);
+    uint64_t bytes_loaded = 0;
+    size_t probe_runs = 0;
+
+    auto job = [&](size_t thread_id, size_t num_threads) {
+      if (thread_id == 0) {
+        utils::Timer timer;
+        timer.start();
+        node = latency::chase(node, num_loads);
+        run_probe_time = timer.stop();
+        probe_done.store(true, std::memory_order_release);
+        return;
+      }
+      uint64_t bytes = 0;
+      auto [begin, end] = utils::partition(data.size(), thread_id - 1, num_threads - 1);
+      for (size_t i = begin; begin < end && !probe_done.load(std::memory_order_acquire);) {
+        // chunks are clamped to the partition of the thread
+        size_t size = std::min(chunk_size, end - i);
+        if (write_load) {
+          write::sequential(data.data() + i, size, static_cast<char>(i));
+        } else {
+          read::sequential(data.data() + i, size);
+        }
+        bytes += size;
+        i = i + size < end ? i + size : begin;
+        latency::spin(delay);
+      }
+      run_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    };
+    auto finish_run = [&] {
+      if (run_pending) {
+        runs.emplace_back(run_probe_time, run_bytes.load());
+        run_pending = false;
+      }
+    };
+    auto prepare = [&](size_t) {
+      finish_run();
+      run_bytes = 0;
+      run_pending = true;
+      probe_done.store(false);
+    };
+
+    _measure_parallel_sweep(
+        name, runtime, pool_size, "delay_ns", delays,
+        [&](uint64_t delay_ns) {
+          delay = std::chrono::nanoseconds(delay_ns);
+          finish_run();
+          runs.clear();
+          probe_time = seconds(0);
+          bytes_loaded = 0;
+          probe_runs = 0;
+          return num_loads * sizeof(latency::Node);
+        },
+        job, prepare,
+        [&](uint64_t) -> nlohmann::json {
+          // the load threads stop as soon as the probe finished: the probe time is the time they were running
+          return {{"load_bps", static_cast<double>(bytes_loaded) / probe_time.count()},
+                  {"probe_latency", probe_time.count() / static_cast<double>(probe_runs * num_loads)}};
+        },
+        {},
+        [&](size_t num_runs) {
+          // only the runs of recorded samples are counted, earlier runs were warmup or calibration runs
+          finish_run();
+          for (auto it = runs.end() - static_cast<std::ptrdiff_t>(std::min(num_runs, runs.size())); it != runs.end();
+               ++it) {
+            probe_time += it->first;
+            bytes_loaded += it->second;
+            ++probe_runs;
+          }
+          runs.clear();
+        });
+
+    delay = std::chrono::nanoseconds(0);
+    _measure_parallel(name, runtime, pool_size, job, prepare);
+    _benchmark_result.at(name).set_parameter("load_threads", pool_size - 1);
+    _benchmark_result.at(name).set_parameter("page_mode", to_string(data.page_mode()));
+
+    if (node == nullptr) {
+      std::cerr << "RAM Benchmarks failed. This line of code should never be reached and only exists to avoid the "
+                   "compiler from optimizing things away...";
+    }
+    _print_latency(_benchmark_result.at(name));
+    if (_verbosity != VERBOSITY::OFF) {
+      std::cout << std::endl;
+    }
+  }
 }
 
 }  // namespace taskbench::ram
\ No newline at end of file
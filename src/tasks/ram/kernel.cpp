@@ -0,0 +1,87 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/ram/kernel.h>
+#include <taskbench/utils/cpu_features.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace taskbench::ram {
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::SCALAR:
+      return "scalar";
+    case Kernel::SSE2:
+      return "sse2";
+    case Kernel::AVX2:
+      return "avx2";
+    case Kernel::AVX512:
+      return "avx512";
+    case Kernel::SSE2_NT:
+      return "sse2_nt";
+    case Kernel::AVX2_NT:
+      return "avx2_nt";
+    case Kernel::AVX512_NT:
+      return "avx512_nt";
+    case Kernel::REP:
+      return "rep";
+  }
+  return "unknown";
+}
+
+// _____________________________________________________________________________________________________________________
+bool is_supported(Kernel kernel) {
+  const auto& features = utils::cpu_features();
+  switch (kernel) {
+    case Kernel::SCALAR:
+      return true;
+    case Kernel::SSE2:
+    case Kernel::SSE2_NT:
+      return features.sse2;
+    case Kernel::AVX2:
+    case Kernel::AVX2_NT:
+      return features.avx2;
+    case Kernel::AVX512:
+    case Kernel::AVX512_NT:
+      return features.avx512f;
+    case Kernel::REP:
+#if defined(TASKBENCH_X86)
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+// _____________________________________________________________________________________________________________________
+void fill_bytes(char* data, size_t size, char value) {
+  volatile char* dst = data;
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = value;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void copy_bytes(const char* src, char* dst, size_t size) {
+  const volatile char* from = src;
+  volatile char* to = dst;
+  for (size_t i = 0; i < size; ++i) {
+    to[i] = from[i];
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+size_t head_size(const char* data, size_t size, size_t alignment) {
+  size_t misalignment = reinterpret_cast<uintptr_t>(data) % alignment;
+  return misalignment == 0 ? 0 : std::min(size, alignment - misalignment);
+}
+
+}  // namespace taskbench::ram
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/ram/latency.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace taskbench::ram::latency {
+
+// _____________________________________________________________________________________________________________________
+Node* build_chain(Node* nodes, size_t num_nodes, unsigned seed) {
+  if (num_nodes == 0) {
+    return nullptr;
+  }
+  std::vector<size_t> order(num_nodes);
+  std::iota(order.begin(), order.end(), 0);
+  // Sattolo's algorithm: a uniformly random permutation consisting of a single cycle
+  std::mt19937_64 rng(seed);
+  for (size_t i = num_nodes - 1; i > 0; --i) {
+    std::uniform_int_distribution<size_t> dist(0, i - 1);
+    std::swap(order[i], order[dist(rng)]);
+  }
+  for (size_t i = 0; i < num_nodes; ++i) {
+    nodes[i].next = &nodes[order[i]];
+  }
+  return &nodes[0];
+}
+
+// _____________________________________________________________________________________________________________________
+const Node* chase(const Node* node, size_t num_loads) {
+  for (size_t i = 0; i < num_loads; ++i) {
+    node = node->next;
+  }
+  return node;
+}
+
+// _____________________________________________________________________________________________________________________
+void spin(std::chrono::nanoseconds delay) {
+  if (delay.count() <= 0) {
+    return;
+  }
+  auto deadline = std::chrono::steady_clock::now() + delay;
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+
+}  // namespace taskbench::ram::latency
\ No newline at end of file
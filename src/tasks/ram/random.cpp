@@ -0,0 +1,51 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/ram/random.h>
+
+#include <atomic>
+
+namespace taskbench::ram::random {
+
+// _____________________________________________________________________________________________________________________
+uint64_t read(const uint64_t* data, const uint64_t* indices, size_t num_indices) {
+  uint64_t res = 0;
+  for (size_t i = 0; i < num_indices; ++i) {
+    res ^= data[indices[i]];
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+uint64_t read_lines(const Line* data, const uint64_t* indices, size_t num_indices) {
+  uint64_t res = 0;
+  for (size_t i = 0; i < num_indices; ++i) {
+    const auto& line = data[indices[i]];
+    for (auto word : line.words) {
+      res ^= word;
+    }
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+void write(uint64_t* data, const uint64_t* indices, size_t num_indices, uint64_t value) {
+  for (size_t i = 0; i < num_indices; ++i) {
+    std::atomic_ref<uint64_t>(data[indices[i]]).store(value, std::memory_order_relaxed);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void write_lines(Line* data, const uint64_t* indices, size_t num_indices, uint64_t value) {
+  for (size_t i = 0; i < num_indices; ++i) {
+    for (auto& word : data[indices[i]].words) {
+      std::atomic_ref<uint64_t>(word).store(value, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace taskbench::ram::random
\ No newline at end of file
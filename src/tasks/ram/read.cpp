@@ -6,17 +6,137 @@
  */
 
 #include <taskbench/tasks/ram/read.h>
+#include <taskbench/utils/cpu_features.h>
 
-#include <cstring>
-#include <iostream>
+#include <stdexcept>
+
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
 
 namespace taskbench::ram::read {
 
-void sequential(const char* data, size_t size) {
-  auto* res = std::memchr(data, '\0', size);
-  if (res != nullptr) {
-    std::cerr << "Sequential RAM Read benchmark did not run properly..." << std::endl;
+/**
+ * @brief xor the bytes that do not fill a whole vector
+ */
+static uint64_t tail(const char* data, size_t size) {
+  uint64_t res = 0;
+  for (size_t i = 0; i < size; ++i) {
+    res ^= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * (i % 8));
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+static uint64_t scalar(const char* data, size_t size) {
+  const volatile auto* words = reinterpret_cast<const volatile uint64_t*>(data);
+  size_t num_words = size / sizeof(uint64_t);
+  uint64_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= num_words; i += 4) {
+    r0 ^= words[i];
+    r1 ^= words[i + 1];
+    r2 ^= words[i + 2];
+    r3 ^= words[i + 3];
+  }
+  for (; i < num_words; ++i) {
+    r0 ^= words[i];
+  }
+  return r0 ^ r1 ^ r2 ^ r3 ^ tail(data + num_words * sizeof(uint64_t), size % sizeof(uint64_t));
+}
+
+#if defined(TASKBENCH_X86)
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("sse2") static uint64_t sse2(const char* data, size_t size) {
+  __m128i r0 = _mm_setzero_si128(), r1 = _mm_setzero_si128(), r2 = _mm_setzero_si128(), r3 = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    r0 = _mm_xor_si128(r0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    r1 = _mm_xor_si128(r1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16)));
+    r2 = _mm_xor_si128(r2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32)));
+    r3 = _mm_xor_si128(r3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48)));
+  }
+  __m128i r = _mm_xor_si128(_mm_xor_si128(r0, r1), _mm_xor_si128(r2, r3));
+  uint64_t words[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words), r);
+  return words[0] ^ words[1] ^ tail(data + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static uint64_t avx2(const char* data, size_t size) {
+  __m256i r0 = _mm256_setzero_si256(), r1 = _mm256_setzero_si256(), r2 = _mm256_setzero_si256(),
+          r3 = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 128 <= size; i += 128) {
+    r0 = _mm256_xor_si256(r0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    r1 = _mm256_xor_si256(r1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32)));
+    r2 = _mm256_xor_si256(r2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 64)));
+    r3 = _mm256_xor_si256(r3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 96)));
   }
+  __m256i r = _mm256_xor_si256(_mm256_xor_si256(r0, r1), _mm256_xor_si256(r2, r3));
+  uint64_t words[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), r);
+  return words[0] ^ words[1] ^ words[2] ^ words[3] ^ tail(data + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx512f") static uint64_t avx512(const char* data, size_t size) {
+  __m512i r0 = _mm512_setzero_si512(), r1 = _mm512_setzero_si512(), r2 = _mm512_setzero_si512(),
+          r3 = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 256 <= size; i += 256) {
+    r0 = _mm512_xor_si512(r0, _mm512_loadu_si512(data + i));
+    r1 = _mm512_xor_si512(r1, _mm512_loadu_si512(data + i + 64));
+    r2 = _mm512_xor_si512(r2, _mm512_loadu_si512(data + i + 128));
+    r3 = _mm512_xor_si512(r3, _mm512_loadu_si512(data + i + 192));
+  }
+  __m512i r = _mm512_xor_si512(_mm512_xor_si512(r0, r1), _mm512_xor_si512(r2, r3));
+  uint64_t words[8];
+  _mm512_storeu_si512(words, r);
+  uint64_t res = 0;
+  for (auto word : words) {
+    res ^= word;
+  }
+  return res ^ tail(data + i, size - i);
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+std::vector<Kernel> kernels() {
+  std::vector<Kernel> res;
+  for (auto kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512}) {
+    if (is_supported(kernel)) {
+      res.push_back(kernel);
+    }
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+Function get(Kernel kernel) {
+  if (is_supported(kernel)) {
+    switch (kernel) {
+      case Kernel::SCALAR:
+        return scalar;
+#if defined(TASKBENCH_X86)
+      case Kernel::SSE2:
+        return sse2;
+      case Kernel::AVX2:
+        return avx2;
+      case Kernel::AVX512:
+        return avx512;
+#endif
+      default:
+        break;
+    }
+  }
+  throw std::runtime_error("RAM read kernel '" + to_string(kernel) + "' is not available.");
+}
+
+// _____________________________________________________________________________________________________________________
+uint64_t sequential(const char* data, size_t size) {
+  static const Function function = get(kernels().back());
+  return function(data, size);
 }
 
 }  // namespace taskbench::ram::read
\ No newline at end of file
@@ -6,11 +6,195 @@
  */
 
 #include <taskbench/tasks/ram/read_write.h>
+#include <taskbench/utils/cpu_features.h>
 
-#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
 
 namespace taskbench::ram::read_write {
 
-void sequential(const int* src, int* dst, size_t size) { std::memcpy(dst, src, size); }
+// _____________________________________________________________________________________________________________________
+static void scalar(const char* src, char* dst, size_t size) {
+  const volatile auto* from = reinterpret_cast<const volatile uint64_t*>(src);
+  volatile auto* to = reinterpret_cast<volatile uint64_t*>(dst);
+  size_t num_words = size / sizeof(uint64_t);
+  for (size_t i = 0; i < num_words; ++i) {
+    to[i] = from[i];
+  }
+  size_t done = num_words * sizeof(uint64_t);
+  copy_bytes(src + done, dst + done, size - done);
+}
+
+#if defined(TASKBENCH_X86)
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("sse2") static void sse2(const char* src, char* dst, size_t size) {
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 16), v1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 32), v2);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 48), v3);
+  }
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("sse2") static void sse2_nt(const char* src, char* dst, size_t size) {
+  size_t i = head_size(dst, size, 16);
+  copy_bytes(src, dst, i);
+  for (; i + 64 <= size; i += 64) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), v3);
+  }
+  _mm_sfence();
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2(const char* src, char* dst, size_t size) {
+  size_t i = 0;
+  for (; i + 128 <= size; i += 128) {
+    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+    __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+    __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), v1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 64), v2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 96), v3);
+  }
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_nt(const char* src, char* dst, size_t size) {
+  size_t i = head_size(dst, size, 32);
+  copy_bytes(src, dst, i);
+  for (; i + 128 <= size; i += 128) {
+    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+    __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+    __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), v1);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 64), v2);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 96), v3);
+  }
+  _mm_sfence();
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx512f") static void avx512(const char* src, char* dst, size_t size) {
+  size_t i = 0;
+  for (; i + 256 <= size; i += 256) {
+    __m512i v0 = _mm512_loadu_si512(src + i);
+    __m512i v1 = _mm512_loadu_si512(src + i + 64);
+    __m512i v2 = _mm512_loadu_si512(src + i + 128);
+    __m512i v3 = _mm512_loadu_si512(src + i + 192);
+    _mm512_storeu_si512(dst + i, v0);
+    _mm512_storeu_si512(dst + i + 64, v1);
+    _mm512_storeu_si512(dst + i + 128, v2);
+    _mm512_storeu_si512(dst + i + 192, v3);
+  }
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx512f") static void avx512_nt(const char* src, char* dst, size_t size) {
+  size_t i = head_size(dst, size, 64);
+  copy_bytes(src, dst, i);
+  for (; i + 256 <= size; i += 256) {
+    __m512i v0 = _mm512_loadu_si512(src + i);
+    __m512i v1 = _mm512_loadu_si512(src + i + 64);
+    __m512i v2 = _mm512_loadu_si512(src + i + 128);
+    __m512i v3 = _mm512_loadu_si512(src + i + 192);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), v0);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 64), v1);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 128), v2);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 192), v3);
+  }
+  _mm_sfence();
+  copy_bytes(src + i, dst + i, size - i);
+}
+
+// _____________________________________________________________________________________________________________________
+static void rep(const char* src, char* dst, size_t size) {
+#if defined(_MSC_VER)
+  __movsb(reinterpret_cast<unsigned char*>(dst), reinterpret_cast<const unsigned char*>(src), size);
+#else
+  __asm__ volatile("rep movsb" : "+D"(dst), "+S"(src), "+c"(size) : : "memory");
+#endif
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+std::vector<Kernel> kernels() {
+  std::vector<Kernel> res;
+  for (auto kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512, Kernel::SSE2_NT, Kernel::AVX2_NT,
+                      Kernel::AVX512_NT, Kernel::REP}) {
+    if (is_supported(kernel)) {
+      res.push_back(kernel);
+    }
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+Function get(Kernel kernel) {
+  if (is_supported(kernel)) {
+    switch (kernel) {
+      case Kernel::SCALAR:
+        return scalar;
+#if defined(TASKBENCH_X86)
+      case Kernel::SSE2:
+        return sse2;
+      case Kernel::AVX2:
+        return avx2;
+      case Kernel::AVX512:
+        return avx512;
+      case Kernel::SSE2_NT:
+        return sse2_nt;
+      case Kernel::AVX2_NT:
+        return avx2_nt;
+      case Kernel::AVX512_NT:
+        return avx512_nt;
+      case Kernel::REP:
+        return rep;
+#endif
+      default:
+        break;
+    }
+  }
+  throw std::runtime_error("RAM read_write kernel '" + to_string(kernel) + "' is not available.");
+}
+
+// _____________________________________________________________________________________________________________________
+void sequential(const char* src, char* dst, size_t size) {
+  static const Function function = [] {
+    for (auto kernel : {Kernel::AVX512, Kernel::AVX2, Kernel::SSE2}) {
+      if (is_supported(kernel)) {
+        return get(kernel);
+      }
+    }
+    return get(Kernel::SCALAR);
+  }();
+  function(src, dst, size);
+}
 
 }  // namespace taskbench::ram::read_write
\ No newline at end of file
@@ -0,0 +1,42 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/ram/stream.h>
+
+namespace taskbench::ram::stream {
+
+// The kernels are plain loops like in the reference implementation of STREAM, vectorization is left to the compiler.
+
+// _____________________________________________________________________________________________________________________
+void copy(const double* __restrict a, double* __restrict c, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    c[i] = a[i];
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void scale(double* __restrict b, const double* __restrict c, double scalar, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    b[i] = scalar * c[i];
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void add(const double* __restrict a, const double* __restrict b, double* __restrict c, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    c[i] = a[i] + b[i];
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void triad(double* __restrict a, const double* __restrict b, const double* __restrict c, double scalar, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    a[i] = b[i] + scalar * c[i];
+  }
+}
+
+}  // namespace taskbench::ram::stream
\ No newline at end of file
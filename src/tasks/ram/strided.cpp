@@ -0,0 +1,29 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/ram/strided.h>
+
+namespace taskbench::ram::strided {
+
+// _____________________________________________________________________________________________________________________
+uint64_t read(const char* data, size_t size, size_t stride) {
+  const auto* words = reinterpret_cast<const uint64_t*>(data);
+  size_t word_stride = stride / sizeof(uint64_t);
+  size_t num_words = size / sizeof(uint64_t);
+  uint64_t r0 = 0, r1 = 0;
+  size_t i = 0;
+  for (; i + word_stride < num_words; i += 2 * word_stride) {
+    r0 ^= words[i];
+    r1 ^= words[i + word_stride];
+  }
+  if (i < num_words) {
+    r0 ^= words[i];
+  }
+  return r0 ^ r1;
+}
+
+}  // namespace taskbench::ram::strided
\ No newline at end of file
@@ -6,11 +6,179 @@
  */
 
 #include <taskbench/tasks/ram/write.h>
+#include <taskbench/utils/cpu_features.h>
 
-#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
 
 namespace taskbench::ram::write {
 
-void sequential(int* buffer, size_t size, int value) { std::memset(buffer, value, size); }
+// _____________________________________________________________________________________________________________________
+static void scalar(char* data, size_t size, char value) {
+  uint64_t word = 0x0101010101010101ULL * static_cast<unsigned char>(value);
+  volatile auto* words = reinterpret_cast<volatile uint64_t*>(data);
+  size_t num_words = size / sizeof(uint64_t);
+  for (size_t i = 0; i < num_words; ++i) {
+    words[i] = word;
+  }
+  fill_bytes(data + num_words * sizeof(uint64_t), size % sizeof(uint64_t), value);
+}
+
+#if defined(TASKBENCH_X86)
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("sse2") static void sse2(char* data, size_t size, char value) {
+  __m128i v = _mm_set1_epi8(value);
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i + 16), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i + 32), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i + 48), v);
+  }
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("sse2") static void sse2_nt(char* data, size_t size, char value) {
+  size_t head = head_size(data, size, 16);
+  fill_bytes(data, head, value);
+  __m128i v = _mm_set1_epi8(value);
+  size_t i = head;
+  for (; i + 64 <= size; i += 64) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(data + i), v);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 16), v);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 32), v);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 48), v);
+  }
+  _mm_sfence();
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2(char* data, size_t size, char value) {
+  __m256i v = _mm256_set1_epi8(value);
+  size_t i = 0;
+  for (; i + 128 <= size; i += 128) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i + 32), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i + 64), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i + 96), v);
+  }
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_nt(char* data, size_t size, char value) {
+  size_t head = head_size(data, size, 32);
+  fill_bytes(data, head, value);
+  __m256i v = _mm256_set1_epi8(value);
+  size_t i = head;
+  for (; i + 128 <= size; i += 128) {
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(data + i), v);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(data + i + 32), v);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(data + i + 64), v);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(data + i + 96), v);
+  }
+  _mm_sfence();
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx512f") static void avx512(char* data, size_t size, char value) {
+  __m512i v = _mm512_set1_epi32(static_cast<int>(0x01010101U * static_cast<unsigned char>(value)));
+  size_t i = 0;
+  for (; i + 256 <= size; i += 256) {
+    _mm512_storeu_si512(data + i, v);
+    _mm512_storeu_si512(data + i + 64, v);
+    _mm512_storeu_si512(data + i + 128, v);
+    _mm512_storeu_si512(data + i + 192, v);
+  }
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx512f") static void avx512_nt(char* data, size_t size, char value) {
+  size_t head = head_size(data, size, 64);
+  fill_bytes(data, head, value);
+  __m512i v = _mm512_set1_epi32(static_cast<int>(0x01010101U * static_cast<unsigned char>(value)));
+  size_t i = head;
+  for (; i + 256 <= size; i += 256) {
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(data + i), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(data + i + 64), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(data + i + 128), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(data + i + 192), v);
+  }
+  _mm_sfence();
+  fill_bytes(data + i, size - i, value);
+}
+
+// _____________________________________________________________________________________________________________________
+static void rep(char* data, size_t size, char value) {
+#if defined(_MSC_VER)
+  __stosb(reinterpret_cast<unsigned char*>(data), static_cast<unsigned char>(value), size);
+#else
+  __asm__ volatile("rep stosb" : "+D"(data), "+c"(size) : "a"(value) : "memory");
+#endif
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+std::vector<Kernel> kernels() {
+  std::vector<Kernel> res;
+  for (auto kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512, Kernel::SSE2_NT, Kernel::AVX2_NT,
+                      Kernel::AVX512_NT, Kernel::REP}) {
+    if (is_supported(kernel)) {
+      res.push_back(kernel);
+    }
+  }
+  return res;
+}
+
+// _____________________________________________________________________________________________________________________
+Function get(Kernel kernel) {
+  if (is_supported(kernel)) {
+    switch (kernel) {
+      case Kernel::SCALAR:
+        return scalar;
+#if defined(TASKBENCH_X86)
+      case Kernel::SSE2:
+        return sse2;
+      case Kernel::AVX2:
+        return avx2;
+      case Kernel::AVX512:
+        return avx512;
+      case Kernel::SSE2_NT:
+        return sse2_nt;
+      case Kernel::AVX2_NT:
+        return avx2_nt;
+      case Kernel::AVX512_NT:
+        return avx512_nt;
+      case Kernel::REP:
+        return rep;
+#endif
+      default:
+        break;
+    }
+  }
+  throw std::runtime_error("RAM write kernel '" + to_string(kernel) + "' is not available.");
+}
+
+// _____________________________________________________________________________________________________________________
+void sequential(char* data, size_t size, char value) {
+  static const Function function = [] {
+    for (auto kernel : {Kernel::AVX512, Kernel::AVX2, Kernel::SSE2}) {
+      if (is_supported(kernel)) {
+        return get(kernel);
+      }
+    }
+    return get(Kernel::SCALAR);
+  }();
+  function(data, size, value);
+}
 
 }  // namespace taskbench::ram::write
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/buffer.h>
+
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace taskbench::utils {
+
+static constexpr size_t page_size = 0x1000;
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(PageMode mode) {
+  switch (mode) {
+    case PageMode::DEFAULT:
+      return "default";
+    case PageMode::SMALL:
+      return "4KiB";
+    case PageMode::THP:
+      return "thp";
+    case PageMode::HUGETLB_2MiB:
+      return "hugetlb_2MiB";
+    case PageMode::HUGETLB_1GiB:
+      return "hugetlb_1GiB";
+  }
+  return "unknown";
+}
+
+#if defined(__linux__)
+/**
+ * @brief Size of the pages used by mode
+ */
+static size_t mode_page_size(PageMode mode) {
+  switch (mode) {
+    case PageMode::HUGETLB_1GiB:
+      return 0x40000000;
+    case PageMode::HUGETLB_2MiB:
+    case PageMode::THP:
+      return 0x200000;
+    default:
+      return page_size;
+  }
+}
+
+/**
+ * @brief mmap anonymous memory of mode, returns nullptr on failure
+ */
+static void* map(size_t bytes, PageMode mode) {
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  if (mode == PageMode::HUGETLB_2MiB) {
+    flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+  } else if (mode == PageMode::HUGETLB_1GiB) {
+    flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+  }
+#else
+  if (mode == PageMode::HUGETLB_2MiB || mode == PageMode::HUGETLB_1GiB) {
+    return nullptr;
+  }
+#endif
+  void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  // the advice must be given before the pages are touched for the first time
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+  if ((mode == PageMode::THP && madvise(memory, bytes, MADV_HUGEPAGE) != 0) ||
+      (mode == PageMode::SMALL && madvise(memory, bytes, MADV_NOHUGEPAGE) != 0)) {
+    munmap(memory, bytes);
+    return nullptr;
+  }
+#endif
+  return memory;
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+RawBuffer::RawBuffer(size_t bytes, PageMode mode) : _bytes(bytes), _requested_page_mode(mode) {
+#if defined(__linux__)
+  while (true) {
+    size_t pages = mode_page_size(mode);
+    _mapped_bytes = (bytes + pages - 1) / pages * pages;
+    _data = map(_mapped_bytes, mode);
+    if (_data != nullptr) {
+      _page_mode = mode;
+      return;
+    }
+    switch (mode) {
+      case PageMode::HUGETLB_1GiB:
+        mode = PageMode::HUGETLB_2MiB;
+        break;
+      case PageMode::HUGETLB_2MiB:
+        mode = PageMode::THP;
+        break;
+      case PageMode::THP:
+      case PageMode::SMALL:
+        mode = PageMode::DEFAULT;
+        break;
+      case PageMode::DEFAULT:
+        throw std::bad_alloc();
+    }
+  }
+#else
+  static_cast<void>(mode);
+  _mapped_bytes = (bytes + page_size - 1) / page_size * page_size;
+  _data = ::operator new(_mapped_bytes, std::align_val_t(page_size));
+  _page_mode = PageMode::DEFAULT;
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+RawBuffer::~RawBuffer() { _release(); }
+
+// _____________________________________________________________________________________________________________________
+RawBuffer::RawBuffer(RawBuffer&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)),
+      _bytes(std::exchange(other._bytes, 0)),
+      _mapped_bytes(std::exchange(other._mapped_bytes, 0)),
+      _page_mode(other._page_mode),
+      _requested_page_mode(other._requested_page_mode) {}
+
+// _____________________________________________________________________________________________________________________
+RawBuffer& RawBuffer::operator=(RawBuffer&& other) noexcept {
+  if (this != &other) {
+    _release();
+    _data = std::exchange(other._data, nullptr);
+    _bytes = std::exchange(other._bytes, 0);
+    _mapped_bytes = std::exchange(other._mapped_bytes, 0);
+    _page_mode = other._page_mode;
+    _requested_page_mode = other._requested_page_mode;
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________________________________________________
+void* RawBuffer::data() const { return _data; }
+
+// _____________________________________________________________________________________________________________________
+size_t RawBuffer::bytes() const { return _bytes; }
+
+// _____________________________________________________________________________________________________________________
+PageMode RawBuffer::page_mode() const { return _page_mode; }
+
+// _____________________________________________________________________________________________________________________
+PageMode RawBuffer::requested_page_mode() const { return _requested_page_mode; }
+
+// _____________________________________________________________________________________________________________________
+void RawBuffer::_release() {
+  if (_data == nullptr) {
+    return;
+  }
+#if defined(__linux__)
+  munmap(_data, _mapped_bytes);
+#else
+  ::operator delete(_data, std::align_val_t(page_size));
+#endif
+  _data = nullptr;
+}
+
+// === BufferPool ======================================================================================================
+// _____________________________________________________________________________________________________________________
+BufferPool& BufferPool::global() {
+  static BufferPool pool;
+  return pool;
+}
+
+// _____________________________________________________________________________________________________________________
+void BufferPool::set_budget(size_t bytes) {
+  std::lock_guard lock(_mutex);
+  _budget = bytes;
+  _shrink();
+}
+
+// _____________________________________________________________________________________________________________________
+size_t BufferPool::budget() const {
+  std::lock_guard lock(_mutex);
+  return _budget;
+}
+
+// _____________________________________________________________________________________________________________________
+RawBuffer BufferPool::acquire(size_t bytes, PageMode mode, bool fresh) {
+  std::unique_lock lock(_mutex);
+  if (!fresh) {
+    // best fit among the cached buffers of the same mode
+    auto best = _cache.end();
+    for (auto it = _cache.begin(); it != _cache.end(); ++it) {
+      if (it->first == mode && it->second.bytes() >= bytes &&
+          (best == _cache.end() || it->second.bytes() < best->second.bytes())) {
+        best = it;
+      }
+    }
+    if (best != _cache.end()) {
+      RawBuffer buffer = std::move(best->second);
+      _cache.erase(best);
+      _cached_bytes -= buffer.bytes();
+      _leased_bytes += buffer.bytes();
+      return buffer;
+    }
+  }
+  // none of the cached buffers fits: unmap them before mapping new memory so that the peak stays bounded by the
+  // memory that is actually leased
+  _cache.clear();
+  _cached_bytes = 0;
+  if (_budget > 0 && _leased_bytes + bytes > _budget) {
+    throw BudgetExceeded("Buffer pool: allocating " + std::to_string(bytes) + " bytes exceeds the memory budget of " +
+                         std::to_string(_budget) + " bytes (" + std::to_string(_leased_bytes) + " bytes leased).");
+  }
+  _leased_bytes += bytes;
+  lock.unlock();
+  try {
+    return {bytes, mode};
+  } catch (...) {
+    lock.lock();
+    _leased_bytes -= bytes;
+    throw;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void BufferPool::release(RawBuffer buffer) {
+  std::lock_guard lock(_mutex);
+  _leased_bytes -= buffer.bytes();
+  _cached_bytes += buffer.bytes();
+  // cached under the requested mode: a buffer that fell back to a weaker mode is reused for the same request
+  _cache.emplace_back(buffer.requested_page_mode(), std::move(buffer));
+  _shrink();
+}
+
+// _____________________________________________________________________________________________________________________
+void BufferPool::clear() {
+  std::lock_guard lock(_mutex);
+  _cache.clear();
+  _cached_bytes = 0;
+}
+
+// _____________________________________________________________________________________________________________________
+size_t BufferPool::leased_bytes() const {
+  std::lock_guard lock(_mutex);
+  return _leased_bytes;
+}
+
+// _____________________________________________________________________________________________________________________
+size_t BufferPool::cached_bytes() const {
+  std::lock_guard lock(_mutex);
+  return _cached_bytes;
+}
+
+// _____________________________________________________________________________________________________________________
+void BufferPool::_shrink() {
+  // unmap the oldest cached buffers until the pool fits into the budget
+  while (!_cache.empty() && _budget > 0 && _leased_bytes + _cached_bytes > _budget) {
+    _cached_bytes -= _cache.front().second.bytes();
+    _cache.erase(_cache.begin());
+  }
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/concurrency.h>
+#include <taskbench/utils/topology.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace taskbench::utils {
+
+/**
+ * @brief Read the first line of a file
+ * @return false if the file could not be read
+ */
+static bool read_line(const std::filesystem::path& path, std::string& value) {
+  std::ifstream file(path);
+  return static_cast<bool>(std::getline(file, value));
+}
+
+/**
+ * @brief Directories of a cgroup and all its ancestors below mount (the cgroup itself first). If the cgroup path is
+ *  not visible below mount (e.g. within a container's cgroup namespace), only mount itself is returned.
+ */
+static std::vector<std::filesystem::path> cgroup_hierarchy(const std::filesystem::path& mount,
+                                                           const std::string& cgroup) {
+  std::vector<std::filesystem::path> result;
+  auto path = mount / std::filesystem::path(cgroup).relative_path();
+  if (!std::filesystem::exists(path)) {
+    return {mount};
+  }
+  for (; path != mount && path.has_relative_path(); path = path.parent_path()) {
+    result.push_back(path);
+  }
+  result.push_back(mount);
+  return result;
+}
+
+/**
+ * @brief Tighten quota (in cpus, 0: unlimited) by a bandwidth limit of quota_us per period_us
+ */
+static void apply_quota(double& quota, double quota_us, double period_us) {
+  if (quota_us <= 0 || period_us <= 0) {
+    return;
+  }
+  double cpus = quota_us / period_us;
+  quota = quota > 0 ? std::min(quota, cpus) : cpus;
+}
+
+/**
+ * @brief Tighten cpuset (0: unlimited) by a cgroup cpu list
+ */
+static void apply_cpuset(size_t& cpuset, const std::string& cpu_list) {
+  auto cpus = parse_cpu_list(cpu_list).size();
+  if (cpus > 0) {
+    cpuset = cpuset > 0 ? std::min(cpuset, cpus) : cpus;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+ConcurrencyLimits detect_concurrency() {
+  ConcurrencyLimits limits;
+  limits.hardware = std::thread::hardware_concurrency();
+  limits.affinity = available_cpus().size();
+
+  std::ifstream proc_cgroup("/proc/self/cgroup");
+  std::string line;
+  while (std::getline(proc_cgroup, line)) {
+    // <hierarchy id>:<controllers>:<path>
+    auto first = line.find(':');
+    auto second = line.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+      continue;
+    }
+    std::string controllers = line.substr(first + 1, second - first - 1);
+    std::string cgroup = line.substr(second + 1);
+    std::string value;
+
+    if (controllers.empty()) {  // cgroup v2
+      for (const auto& dir : cgroup_hierarchy("/sys/fs/cgroup", cgroup)) {
+        if (read_line(dir / "cpu.max", value)) {
+          // "<quota> <period>" or "max <period>"
+          std::stringstream stream(value);
+          std::string quota_us;
+          double period_us = 0;
+          stream >> quota_us >> period_us;
+          if (quota_us != "max") {
+            apply_quota(limits.cpu_quota, std::stod(quota_us), period_us);
+          }
+        }
+        if (read_line(dir / "cpuset.cpus.effective", value)) {
+          apply_cpuset(limits.cpuset, value);
+        }
+      }
+      continue;
+    }
+
+    std::stringstream stream(controllers);
+    std::string controller;
+    while (std::getline(stream, controller, ',')) {
+      if (controller == "cpu") {
+        for (const auto& mount : {"/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct"}) {
+          for (const auto& dir : cgroup_hierarchy(mount, cgroup)) {
+            std::string period;
+            if (read_line(dir / "cpu.cfs_quota_us", value) && read_line(dir / "cpu.cfs_period_us", period)) {
+              apply_quota(limits.cpu_quota, std::stod(value), std::stod(period));
+            }
+          }
+        }
+      } else if (controller == "cpuset") {
+        auto dirs = cgroup_hierarchy("/sys/fs/cgroup/cpuset", cgroup);
+        if (read_line(dirs.front() / "cpuset.effective_cpus", value) ||
+            read_line(dirs.front() / "cpuset.cpus", value)) {
+          apply_cpuset(limits.cpuset, value);
+        }
+      }
+    }
+  }
+
+  size_t effective = limits.hardware;
+  for (size_t limit : {limits.affinity, limits.cpuset, static_cast<size_t>(std::ceil(limits.cpu_quota))}) {
+    if (limit > 0) {
+      effective = effective > 0 ? std::min(effective, limit) : limit;
+    }
+  }
+  limits.effective = std::max<size_t>(effective, 1);
+  return limits;
+}
+
+// _____________________________________________________________________________________________________________________
+size_t default_concurrency() {
+  static const size_t concurrency = detect_concurrency().effective;
+  return concurrency;
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/cpu_features.h>
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(TASKBENCH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace taskbench::utils {
+
+#if defined(TASKBENCH_X86)
+/**
+ * @brief Registers eax, ebx, ecx, edx of CPUID leaf/subleaf (all 0 if the leaf is not supported)
+ */
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t (&regs)[4]) {
+#if defined(_MSC_VER)
+  int values[4];
+  __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) {
+    regs[i] = static_cast<uint32_t>(values[i]);
+  }
+#else
+  if (__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]) == 0) {
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+  }
+#endif
+}
+
+/**
+ * @brief Extended control register 0: the register states the operating system saves on context switches
+ */
+static uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+/**
+ * @brief Detect the cpu features
+ */
+static CpuFeatures detect_cpu_features() {
+  CpuFeatures features;
+#if defined(TASKBENCH_X86)
+  uint32_t regs[4];
+  cpuid(0, 0, regs);
+  uint32_t max_leaf = regs[0];
+  if (max_leaf < 1) {
+    return features;
+  }
+  cpuid(1, 0, regs);
+  features.sse2 = (regs[3] >> 26) & 1;
+  bool ssse3 = (regs[2] >> 9) & 1;
+  features.aesni = ssse3 && ((regs[2] >> 25) & 1);
+  features.pclmulqdq = ssse3 && ((regs[2] >> 1) & 1);
+  bool osxsave = (regs[2] >> 27) & 1;
+  bool avx = (regs[2] >> 28) & 1;
+  uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+  // xmm and ymm state, additionally opmask and upper zmm state for AVX-512
+  bool os_avx = (xcr0 & 0x6) == 0x6;
+  bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+  if (max_leaf >= 7) {
+    cpuid(7, 0, regs);
+    features.avx2 = avx && os_avx && ((regs[1] >> 5) & 1);
+    features.avx512f = os_avx512 && ((regs[1] >> 16) & 1);
+    features.erms = (regs[1] >> 9) & 1;
+    features.fsrm = (regs[3] >> 4) & 1;
+    features.vaes = features.avx2 && features.aesni && ((regs[2] >> 9) & 1);
+    features.vpclmulqdq = features.avx2 && features.pclmulqdq && ((regs[2] >> 10) & 1);
+  }
+  cpuid(0x80000000, 0, regs);
+  if (regs[0] >= 0x80000007) {
+    cpuid(0x80000007, 0, regs);
+    features.invariant_tsc = (regs[3] >> 8) & 1;
+  }
+#endif
+  return features;
+}
+
+// _____________________________________________________________________________________________________________________
+const CpuFeatures& cpu_features() {
+  static const CpuFeatures features = detect_cpu_features();
+  return features;
+}
+
+// _____________________________________________________________________________________________________________________
+double tsc_frequency() {
+  static const double frequency = [] {
+#if defined(TASKBENCH_X86)
+    if (!cpu_features().invariant_tsc) {
+      return 0.0;
+    }
+    // busy wait for 20 ms: long enough to make the clock resolution and the cost of reading both clocks negligible
+    auto start = std::chrono::steady_clock::now();
+    uint64_t start_ticks = __rdtsc();
+    auto stop = start;
+    while (stop - start < std::chrono::milliseconds(20)) {
+      stop = std::chrono::steady_clock::now();
+    }
+    uint64_t stop_ticks = __rdtsc();
+    return static_cast<double>(stop_ticks - start_ticks) / std::chrono::duration<double>(stop - start).count();
+#else
+    return 0.0;
+#endif
+  }();
+  return frequency;
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
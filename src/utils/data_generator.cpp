@@ -5,8 +5,428 @@
  * This file is part of taskbench.
  */
 
+#include <taskbench/utils/concurrency.h>
+#include <taskbench/utils/cpu_features.h>
 #include <taskbench/utils/data_generator.h>
+#include <taskbench/utils/worker_pool.h>
 
-#include <random>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <string_view>
+#include <thread>
 
-namespace taskbench::utils {}
\ No newline at end of file
+#if defined(TASKBENCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace taskbench::utils {
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::UNIFORM:
+      return "uniform";
+    case Distribution::ZIPF:
+      return "zipf";
+    case Distribution::SORTED:
+      return "sorted";
+    case Distribution::REVERSE_SORTED:
+      return "reverse_sorted";
+    case Distribution::NEARLY_SORTED:
+      return "nearly_sorted";
+    case Distribution::FEW_UNIQUE:
+      return "few_unique";
+  }
+  return "unknown";
+}
+
+// _____________________________________________________________________________________________________________________
+double default_parameter(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::ZIPF:
+    case Distribution::NEARLY_SORTED:
+      return 1.0;
+    case Distribution::FEW_UNIQUE:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace taskbench::utils
+
+namespace taskbench::utils::rng {
+
+// sizes below this are generated by the calling thread
+static constexpr size_t min_parallel_size = 1 << 18;
+
+static constexpr uint64_t golden_gamma = 0x9e3779b97f4a7c15;
+
+// _____________________________________________________________________________________________________________________
+static uint64_t mulhi(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+  uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32, b_lo = b & 0xffffffff, b_hi = b >> 32;
+  uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+  return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+// the word is mapped to the unit interval by using its upper bits as mantissa of a number in [1, 2)
+// _____________________________________________________________________________________________________________________
+static double unit_double(uint64_t word) { return std::bit_cast<double>((word >> 12) | 0x3ff0000000000000) - 1.0; }
+
+// _____________________________________________________________________________________________________________________
+static float unit_float(uint64_t word) {
+  return std::bit_cast<float>(static_cast<uint32_t>(word >> 41) | 0x3f800000) - 1.0f;
+}
+
+// _____________________________________________________________________________________________________________________
+static void scalar_u64(uint64_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range) {
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t w = word(key, index + i);
+    out[i] = range == 0 ? w : mulhi(w, range);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+static void scalar_u32(uint32_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<uint32_t>(((word(key, index + i) >> 32) * range) >> 32);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+static void scalar_f64(double* out, size_t size, uint64_t key, uint64_t index, double min, double max) {
+  double range = max - min;
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = min + unit_double(word(key, index + i)) * range;
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+static void scalar_f32(float* out, size_t size, uint64_t key, uint64_t index, float min, float max) {
+  float range = max - min;
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = min + unit_float(word(key, index + i)) * range;
+  }
+}
+
+#if defined(TASKBENCH_X86)
+/**
+ * @brief Lane wise 64 bit multiplication (AVX2 only provides 32 x 32 -> 64 bit multiplications)
+ */
+TASKBENCH_TARGET("avx2") static __m256i mullo64(__m256i a, __m256i b) {
+  __m256i lo = _mm256_mul_epu32(a, b);
+  __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                    _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+/**
+ * @brief Four consecutive words of a stream: the counters are advanced by 4 * golden_gamma per call
+ */
+struct Avx2Words {
+  TASKBENCH_TARGET("avx2") Avx2Words(uint64_t key, uint64_t index) {
+    state = _mm256_set_epi64x(static_cast<int64_t>(key + (index + 4) * golden_gamma),
+                              static_cast<int64_t>(key + (index + 3) * golden_gamma),
+                              static_cast<int64_t>(key + (index + 2) * golden_gamma),
+                              static_cast<int64_t>(key + (index + 1) * golden_gamma));
+    step = _mm256_set1_epi64x(static_cast<int64_t>(4 * golden_gamma));
+    m1 = _mm256_set1_epi64x(static_cast<int64_t>(0xbf58476d1ce4e5b9));
+    m2 = _mm256_set1_epi64x(static_cast<int64_t>(0x94d049bb133111eb));
+  }
+
+  TASKBENCH_TARGET("avx2") __m256i next() {
+    __m256i z = state;
+    state = _mm256_add_epi64(state, step);
+    z = mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), m1);
+    z = mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), m2);
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+  }
+
+  __m256i state, step, m1, m2;
+};
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_u64(uint64_t* out, size_t size, uint64_t key, uint64_t index,
+                                              uint64_t range) {
+  if (range != 0) {
+    // 64 x 64 bit high multiplication is not available as vector instruction
+    scalar_u64(out, size, key, index, range);
+    return;
+  }
+  Avx2Words words(key, index);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), words.next());
+  }
+  scalar_u64(out + i, size - i, key, index + i, range);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_u32(uint32_t* out, size_t size, uint64_t key, uint64_t index,
+                                              uint64_t range) {
+  Avx2Words words(key, index);
+  // the upper 32 bit of each 64 bit lane
+  const __m256i upper = _mm256_set_epi32(7, 5, 3, 1, 7, 5, 3, 1);
+  const __m256i vrange = _mm256_set1_epi64x(static_cast<int64_t>(range));
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256i w = words.next();
+    // range == 2^32 does not fit the 32 bit multiplication but maps the upper half of the word to itself
+    __m256i r = range == (uint64_t(1) << 32) ? w : _mm256_mul_epu32(_mm256_srli_epi64(w, 32), vrange);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(r, upper)));
+  }
+  scalar_u32(out + i, size - i, key, index + i, range);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_f64(double* out, size_t size, uint64_t key, uint64_t index, double min,
+                                              double max) {
+  Avx2Words words(key, index);
+  const __m256i exponent = _mm256_set1_epi64x(0x3ff0000000000000);
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d vmin = _mm256_set1_pd(min);
+  const __m256d vrange = _mm256_set1_pd(max - min);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256i bits = _mm256_or_si256(_mm256_srli_epi64(words.next(), 12), exponent);
+    __m256d unit = _mm256_sub_pd(_mm256_castsi256_pd(bits), one);
+    _mm256_storeu_pd(out + i, _mm256_add_pd(vmin, _mm256_mul_pd(unit, vrange)));
+  }
+  scalar_f64(out + i, size - i, key, index + i, min, max);
+}
+
+// _____________________________________________________________________________________________________________________
+TASKBENCH_TARGET("avx2") static void avx2_f32(float* out, size_t size, uint64_t key, uint64_t index, float min,
+                                              float max) {
+  Avx2Words words(key, index);
+  // the lower 32 bit of each 64 bit lane
+  const __m256i lower = _mm256_set_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+  const __m128i exponent = _mm_set1_epi32(0x3f800000);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 vmin = _mm_set1_ps(min);
+  const __m128 vrange = _mm_set1_ps(max - min);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256i shifted = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(words.next(), 41), lower);
+    __m128i bits = _mm_or_si128(_mm256_castsi256_si128(shifted), exponent);
+    __m128 unit = _mm_sub_ps(_mm_castsi128_ps(bits), one);
+    _mm_storeu_ps(out + i, _mm_add_ps(vmin, _mm_mul_ps(unit, vrange)));
+  }
+  scalar_f32(out + i, size - i, key, index + i, min, max);
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+void fill(uint64_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range) {
+#if defined(TASKBENCH_X86)
+  static const auto function = cpu_features().avx2 ? avx2_u64 : scalar_u64;
+#else
+  static const auto function = scalar_u64;
+#endif
+  function(out, size, key, index, range);
+}
+
+// _____________________________________________________________________________________________________________________
+void fill(uint32_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range) {
+#if defined(TASKBENCH_X86)
+  static const auto function = cpu_features().avx2 ? avx2_u32 : scalar_u32;
+#else
+  static const auto function = scalar_u32;
+#endif
+  function(out, size, key, index, range);
+}
+
+// _____________________________________________________________________________________________________________________
+void fill(double* out, size_t size, uint64_t key, uint64_t index, double min, double max) {
+#if defined(TASKBENCH_X86)
+  static const auto function = cpu_features().avx2 ? avx2_f64 : scalar_f64;
+#else
+  static const auto function = scalar_f64;
+#endif
+  function(out, size, key, index, min, max);
+}
+
+// _____________________________________________________________________________________________________________________
+void fill(float* out, size_t size, uint64_t key, uint64_t index, float min, float max) {
+#if defined(TASKBENCH_X86)
+  static const auto function = cpu_features().avx2 ? avx2_f32 : scalar_f32;
+#else
+  static const auto function = scalar_f32;
+#endif
+  function(out, size, key, index, min, max);
+}
+
+/**
+ * @brief Discrete Zipf distribution: ranks in [0, n) with probability proportional to 1 / (rank + 1)^s, sampled by
+ *  rejection-inversion (Hoermann, Derflinger: Rejection-inversion to generate variates from monotone discrete
+ *  distributions, 1996). The first attempt uses the given word, the rare further attempts draw from a stream keyed by
+ *  it, so that every value still depends on its counter only.
+ */
+class Zipf {
+ public:
+  Zipf(double n, double s)
+      : _n(n),
+        _s(s),
+        _h_integral_x1(_h_integral(1.5) - 1),
+        _h_integral_n(_h_integral(n + 0.5)),
+        _threshold(2 - _h_integral_inverse(_h_integral(2.5) - _h(2))) {}
+
+  uint64_t operator()(uint64_t w) const {
+    for (uint64_t attempt = 0;; ++attempt) {
+      double r = unit_double(attempt == 0 ? w : word(rng::key(w), attempt));
+      double u = _h_integral_n + r * (_h_integral_x1 - _h_integral_n);
+      double x = _h_integral_inverse(u);
+      double k = std::clamp(std::floor(x + 0.5), 1.0, _n);
+      if (k - x <= _threshold || u >= _h_integral(k + 0.5) - _h(k)) {
+        return static_cast<uint64_t>(k) - 1;
+      }
+    }
+  }
+
+ private:
+  // h(x) = 1 / x^s, the unnormalized probability of rank x - 1
+  [[nodiscard]] double _h(double x) const { return std::exp(-_s * std::log(x)); }
+
+  // integral of h, continuous in s = 1: (x^(1 - s) - 1) / (1 - s), log(x) for s = 1
+  [[nodiscard]] double _h_integral(double x) const {
+    double log_x = std::log(x);
+    return expm1_over_x((1 - _s) * log_x) * log_x;
+  }
+
+  [[nodiscard]] double _h_integral_inverse(double x) const {
+    double t = std::max(x * (1 - _s), -1.0);
+    return std::exp(log1p_over_x(t) * x);
+  }
+
+  // expm1(x) / x and log1p(x) / x, continued by their limit 1 at 0
+  static double expm1_over_x(double x) { return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1 + x / 2; }
+  static double log1p_over_x(double x) { return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1 - x / 2; }
+
+  double _n;
+  double _s;
+  double _h_integral_x1;
+  double _h_integral_n;
+  double _threshold;
+};
+
+/**
+ * @brief Offset of the index-th of total ascending values in [0, range): index * range / total plus a random fraction
+ *  of range / total
+ */
+static uint64_t sorted_offset(uint64_t w, uint64_t index, uint64_t range, size_t total) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 position = range == 0 ? (static_cast<unsigned __int128>(index) << 64) + w
+                                          : static_cast<unsigned __int128>(index) * range + mulhi(w, range);
+  return static_cast<uint64_t>(position / total);
+#else
+  long double scale = range == 0 ? 0x1p64L : static_cast<long double>(range);
+  return static_cast<uint64_t>((static_cast<long double>(index) + unit_double(w)) * scale / total);
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+void fill(uint64_t* out, size_t size, uint64_t key, uint64_t index, uint64_t range, size_t total,
+          Distribution distribution, double parameter) {
+  switch (distribution) {
+    case Distribution::UNIFORM:
+      fill(out, size, key, index, range);
+      return;
+    case Distribution::ZIPF: {
+      // ranks beyond 2^53 are not representable by the inversion
+      double n = range == 0 || range > (uint64_t(1) << 53) ? 0x1p53 : static_cast<double>(range);
+      Zipf zipf(n, parameter);
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = zipf(word(key, index + i));
+      }
+      return;
+    }
+    case Distribution::SORTED:
+    case Distribution::NEARLY_SORTED:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = sorted_offset(word(key, index + i), index + i, range, total);
+      }
+      return;
+    case Distribution::REVERSE_SORTED:
+      for (size_t i = 0; i < size; ++i) {
+        uint64_t mirrored = total - 1 - (index + i);
+        out[i] = sorted_offset(word(key, mirrored), mirrored, range, total);
+      }
+      return;
+    case Distribution::FEW_UNIQUE: {
+      // the distinct values are the first words of an independent stream
+      auto num_values = static_cast<uint64_t>(std::max(parameter, 1.0));
+      uint64_t values_key = rng::key(key);
+      for (size_t i = 0; i < size; ++i) {
+        uint64_t w = word(values_key, mulhi(word(key, index + i), num_values));
+        out[i] = range == 0 ? w : mulhi(w, range);
+      }
+      return;
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+void text(char* out, size_t size, uint64_t key, size_t vocabulary, double skew) {
+  // vocabulary of lower case words with 1 to 12 letters
+  std::vector<std::string> words(std::max<size_t>(vocabulary, 1));
+  uint64_t vocabulary_key = rng::key(key);
+  for (size_t i = 0; i < words.size(); ++i) {
+    words[i] = std::string(1 + mulhi(word(vocabulary_key, i), 12), ' ');
+    uint64_t letters_key = rng::key(word(vocabulary_key, i));
+    for (size_t j = 0; j < words[i].size(); ++j) {
+      words[i][j] = static_cast<char>('a' + mulhi(word(letters_key, j), 26));
+    }
+  }
+
+  Zipf zipf(static_cast<double>(words.size()), skew);
+
+  // every block of block_size bytes is generated by an independent stream
+  parallel_for(size, [&](size_t begin, size_t end) {
+    for (size_t block = begin; block < end; block += block_size) {
+      uint64_t block_key = rng::key(key ^ block);
+      size_t block_end = std::min(block + block_size, end);
+      for (size_t pos = block, counter = 0; pos < block_end; ++counter) {
+        uint64_t w = word(block_key, counter);
+        const auto& next = words[zipf(w)];
+        size_t n = std::min(next.size(), block_end - pos);
+        std::copy_n(next.data(), n, out + pos);
+        pos += n;
+        // the lower bits are not used for the rank: one in 16 words ends a line, one in 8 a clause
+        uint64_t r = w & 0xff;
+        std::string_view separator = r < 16 ? ".\n" : r < 48 ? ", " : " ";
+        n = std::min(separator.size(), block_end - pos);
+        std::copy_n(separator.data(), n, out + pos);
+        pos += n;
+      }
+    }
+  });
+}
+
+// _____________________________________________________________________________________________________________________
+void parallel_for(size_t size, const std::function<void(size_t, size_t)>& job) {
+  size_t num_blocks = (size + block_size - 1) / block_size;
+  size_t num_threads = std::min(default_concurrency(), num_blocks);
+  if (size < min_parallel_size || num_threads <= 1) {
+    job(0, size);
+    return;
+  }
+  std::vector<std::jthread> threads;
+  threads.reserve(num_threads - 1);
+  auto run = [&](size_t thread_id) {
+    auto [first, last] = partition(num_blocks, thread_id, num_threads);
+    job(first * block_size, std::min(last * block_size, size));
+  };
+  for (size_t thread_id = 1; thread_id < num_threads; ++thread_id) {
+    threads.emplace_back(run, thread_id);
+  }
+  run(0);
+}
+
+}  // namespace taskbench::utils::rng
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/mapped_file.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TASKBENCH_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace taskbench::utils {
+
+// _____________________________________________________________________________________________________________________
+MappedFile::MappedFile(std::string path) : _path(std::move(path)) {
+#if defined(TASKBENCH_MMAP)
+  int fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open '" + _path + "': " + std::strerror(errno));
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Cannot stat '" + _path + "': " + std::strerror(errno));
+  }
+  _size = static_cast<size_t>(info.st_size);
+  if (_size > 0) {
+    void* memory = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (memory == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Cannot map '" + _path + "': " + std::strerror(errno));
+    }
+    // benchmarks stream through the file: read ahead aggressively
+    madvise(memory, _size, MADV_SEQUENTIAL);
+    madvise(memory, _size, MADV_WILLNEED);
+    _data = static_cast<const char*>(memory);
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+#else
+  std::ifstream file(_path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("Cannot open '" + _path + "'.");
+  }
+  _size = static_cast<size_t>(file.tellg());
+  _copy = std::make_unique<char[]>(_size);
+  file.seekg(0);
+  file.read(_copy.get(), static_cast<std::streamsize>(_size));
+  _data = _copy.get();
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+MappedFile::~MappedFile() { _release(); }
+
+// _____________________________________________________________________________________________________________________
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _path(std::move(other._path)),
+      _data(std::exchange(other._data, nullptr)),
+      _size(std::exchange(other._size, 0)),
+      _copy(std::move(other._copy)) {}
+
+// _____________________________________________________________________________________________________________________
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    _release();
+    _path = std::move(other._path);
+    _data = std::exchange(other._data, nullptr);
+    _size = std::exchange(other._size, 0);
+    _copy = std::move(other._copy);
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________________________________________________
+const char* MappedFile::data() const { return _data; }
+
+// _____________________________________________________________________________________________________________________
+size_t MappedFile::size() const { return _size; }
+
+// _____________________________________________________________________________________________________________________
+const std::string& MappedFile::path() const { return _path; }
+
+// _____________________________________________________________________________________________________________________
+void MappedFile::prefault() const {
+  const volatile char* data = _data;
+  char sum = 0;
+  for (size_t i = 0; i < _size; i += 0x1000) {
+    sum = static_cast<char>(sum ^ data[i]);
+  }
+  static_cast<void>(sum);
+}
+
+// _____________________________________________________________________________________________________________________
+std::vector<std::string_view> MappedFile::lines() const {
+  std::vector<std::string_view> result;
+  const char* end = _data + _size;
+  for (const char* line = _data; line < end;) {
+    const char* line_end = std::find(line, end, '\n');
+    result.emplace_back(line, static_cast<size_t>(line_end - line));
+    line = line_end + 1;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________________________________________________
+void MappedFile::_release() {
+#if defined(TASKBENCH_MMAP)
+  if (_data != nullptr) {
+    munmap(const_cast<char*>(_data), _size);
+  }
+#endif
+  _data = nullptr;
+  _size = 0;
+  _copy.reset();
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/memory.h>
+
+#include <fstream>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace taskbench::utils {
+
+#if defined(__linux__)
+/**
+ * @brief Value of field (in kB) from /proc/self/status in bytes (0 if not available)
+ */
+static size_t proc_status_bytes(const std::string& field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with(field) && line.size() > field.size() && line[field.size()] == ':') {
+      return std::stoull(line.substr(field.size() + 1)) * 1024;
+    }
+  }
+  return 0;
+}
+#endif
+
+// _____________________________________________________________________________________________________________________
+size_t current_rss() {
+#if defined(__linux__)
+  return proc_status_bytes("VmRSS");
+#else
+  return 0;
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+size_t peak_rss() {
+#if defined(__linux__)
+  if (auto bytes = proc_status_bytes("VmHWM"); bytes > 0) {
+    return bytes;
+  }
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+void reset_peak_rss() {
+#if defined(__linux__)
+  // "5" resets the peak resident set size (VmHWM) of the process, fails silently without permission
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+#endif
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/topology.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace taskbench::utils {
+
+/**
+ * @brief Read the first line of a sysfs file
+ * @return false if the file could not be read
+ */
+static bool read_sysfs(const std::string& path, std::string& value) {
+  std::ifstream file(path);
+  return static_cast<bool>(std::getline(file, value));
+}
+
+// _____________________________________________________________________________________________________________________
+std::string to_string(Placement placement) {
+  switch (placement) {
+    case Placement::NONE:
+      return "none";
+    case Placement::COMPACT:
+      return "compact";
+    case Placement::SCATTER:
+      return "scatter";
+    case Placement::PHYSICAL_CORES:
+      return "physical_cores";
+    case Placement::SMT_PAIRS:
+      return "smt_pairs";
+    case Placement::NUMA_NODE:
+      return "numa_node";
+  }
+  return "unknown";
+}
+
+// _____________________________________________________________________________________________________________________
+Topology Topology::detect() {
+  Topology topology;
+  auto cpu_ids = available_cpus();
+  if (cpu_ids.empty()) {
+    for (int id = 0; id < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++id) {
+      cpu_ids.push_back(id);
+    }
+  }
+
+  std::map<int, int> node_of_cpu;
+  std::string value;
+  if (read_sysfs("/sys/devices/system/node/online", value)) {
+    for (int node : parse_cpu_list(value)) {
+      std::string cpu_list;
+      if (read_sysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", cpu_list)) {
+        for (int cpu : parse_cpu_list(cpu_list)) {
+          node_of_cpu[cpu] = node;
+        }
+      }
+    }
+  }
+
+  for (int id : cpu_ids) {
+    std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+    Cpu cpu{id, id, 0, node_of_cpu.contains(id) ? node_of_cpu[id] : 0, 0};
+    if (read_sysfs(base + "core_id", value)) {
+      cpu.core_id = std::stoi(value);
+    }
+    if (read_sysfs(base + "physical_package_id", value)) {
+      cpu.package_id = std::stoi(value);
+    }
+    if (read_sysfs(base + "thread_siblings_list", value)) {
+      auto siblings = parse_cpu_list(value);
+      cpu.smt_index =
+          static_cast<int>(std::count_if(siblings.begin(), siblings.end(), [id](int s) { return s < id; }));
+    }
+    topology._cpus.push_back(cpu);
+  }
+  return topology;
+}
+
+// _____________________________________________________________________________________________________________________
+const Topology& Topology::system() {
+  static const Topology topology = detect();
+  return topology;
+}
+
+// _____________________________________________________________________________________________________________________
+const std::vector<Cpu>& Topology::cpus() const { return _cpus; }
+
+// _____________________________________________________________________________________________________________________
+size_t Topology::num_cores() const {
+  std::set<std::pair<int, int>> cores;
+  for (const auto& cpu : _cpus) {
+    cores.insert({cpu.package_id, cpu.core_id});
+  }
+  return cores.size();
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Topology::num_packages() const {
+  std::set<int> packages;
+  for (const auto& cpu : _cpus) {
+    packages.insert(cpu.package_id);
+  }
+  return packages.size();
+}
+
+// _____________________________________________________________________________________________________________________
+size_t Topology::num_nodes() const {
+  std::set<int> nodes;
+  for (const auto& cpu : _cpus) {
+    nodes.insert(cpu.node_id);
+  }
+  return nodes.size();
+}
+
+// _____________________________________________________________________________________________________________________
+std::vector<int> Topology::place(Placement placement, size_t num_threads, int node) const {
+  if (placement == Placement::NONE || _cpus.empty()) {
+    return {};
+  }
+  std::vector<Cpu> cpus = _cpus;
+  auto compact_order = [](const Cpu& a, const Cpu& b) {
+    return std::tie(a.package_id, a.core_id, a.smt_index) < std::tie(b.package_id, b.core_id, b.smt_index);
+  };
+
+  switch (placement) {
+    case Placement::COMPACT:
+      std::sort(cpus.begin(), cpus.end(), compact_order);
+      break;
+    case Placement::SCATTER: {
+      // round robin over packages: first core of every package, second core of every package, ... then SMT siblings
+      std::sort(cpus.begin(), cpus.end(), compact_order);
+      std::map<int, int> core_rank;
+      std::map<std::pair<int, int>, int> rank_of_core;
+      for (const auto& cpu : cpus) {
+        if (!rank_of_core.contains({cpu.package_id, cpu.core_id})) {
+          rank_of_core[{cpu.package_id, cpu.core_id}] = core_rank[cpu.package_id]++;
+        }
+      }
+      std::stable_sort(cpus.begin(), cpus.end(), [&](const Cpu& a, const Cpu& b) {
+        return std::make_tuple(a.smt_index, rank_of_core.at({a.package_id, a.core_id}), a.package_id) <
+               std::make_tuple(b.smt_index, rank_of_core.at({b.package_id, b.core_id}), b.package_id);
+      });
+      break;
+    }
+    case Placement::PHYSICAL_CORES:
+      std::erase_if(cpus, [](const Cpu& cpu) { return cpu.smt_index != 0; });
+      std::sort(cpus.begin(), cpus.end(), compact_order);
+      break;
+    case Placement::SMT_PAIRS: {
+      std::map<std::pair<int, int>, int> siblings_per_core;
+      for (const auto& cpu : cpus) {
+        siblings_per_core[{cpu.package_id, cpu.core_id}]++;
+      }
+      std::erase_if(cpus, [&](const Cpu& cpu) {
+        return cpu.smt_index > 1 || siblings_per_core.at({cpu.package_id, cpu.core_id}) < 2;
+      });
+      std::sort(cpus.begin(), cpus.end(), compact_order);
+      break;
+    }
+    case Placement::NUMA_NODE:
+      std::erase_if(cpus, [node](const Cpu& cpu) { return cpu.node_id != node; });
+      std::sort(cpus.begin(), cpus.end(), compact_order);
+      break;
+    case Placement::NONE:
+      break;
+  }
+  if (cpus.empty()) {
+    // the requested cpus do not exist on this machine (e.g. no SMT or an unknown NUMA node)
+    std::string reason = placement == Placement::NUMA_NODE ? "NUMA node " + std::to_string(node) + " has no usable cpus"
+                                                           : "no usable cpus match the placement";
+    throw std::runtime_error("Placement '" + to_string(placement) + "' is not possible on this machine: " + reason +
+                             ".");
+  }
+
+  std::vector<int> result;
+  for (size_t i = 0; i < std::min(num_threads, cpus.size()); ++i) {
+    result.push_back(cpus[i].id);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________________________________________________
+bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+// _____________________________________________________________________________________________________________________
+std::vector<int> available_cpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+// _____________________________________________________________________________________________________________________
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || !std::isdigit(static_cast<unsigned char>(range.front()))) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/utils/topology.h>
+#include <taskbench/utils/worker_pool.h>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define TASKBENCH_SPIN_PAUSE() _mm_pause()
+#else
+#define TASKBENCH_SPIN_PAUSE() std::this_thread::yield()
+#endif
+
+namespace taskbench::utils {
+
+/**
+ * @brief Busy wait until pred() holds. Falls back to yielding after a while so that an oversubscribed system (more
+ *  workers than cpus) still makes progress.
+ */
+template <typename Pred>
+static void spin_until(Pred pred) {
+  for (int i = 0; !pred(); ++i) {
+    if (i < 4096) {
+      TASKBENCH_SPIN_PAUSE();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+WorkerPool::WorkerPool(size_t num_threads, std::vector<int> cpus)
+    : _cpus(std::move(cpus)),
+      _start_times(num_threads),
+      _finish_times(num_threads),
+      _timings(num_threads),
+      _exceptions(num_threads) {
+  _threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    _threads.emplace_back(&WorkerPool::_work, this, i);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+WorkerPool::~WorkerPool() {
+  {
+    std::unique_lock lock(_mutex);
+    _shutdown = true;
+  }
+  _cv.notify_all();
+  for (auto& thread : _threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+std::chrono::duration<double> WorkerPool::run(const std::function<void(size_t)>& job) {
+  uint64_t generation;
+  {
+    std::unique_lock lock(_mutex);
+    _job = &job;
+    _ready.store(0, std::memory_order_relaxed);
+    _done.store(0, std::memory_order_relaxed);
+    generation = ++_generation;
+  }
+  _cv.notify_all();
+
+  // all workers are spinning at the barrier once they reported ready
+  spin_until([&] { return _ready.load(std::memory_order_acquire) == _threads.size(); });
+  auto release = clock::now();
+  _released.store(generation, std::memory_order_release);
+  spin_until([&] { return _done.load(std::memory_order_acquire) == _threads.size(); });
+
+  auto last_finish = release;
+  for (size_t i = 0; i < _threads.size(); ++i) {
+    _timings[i] = {_start_times[i] - release, _finish_times[i] - release};
+    last_finish = std::max(last_finish, _finish_times[i]);
+  }
+  for (auto& e : _exceptions) {
+    if (e) {
+      std::rethrow_exception(std::exchange(e, nullptr));
+    }
+  }
+  return last_finish - release;
+}
+
+// _____________________________________________________________________________________________________________________
+size_t WorkerPool::size() const { return _threads.size(); }
+
+// _____________________________________________________________________________________________________________________
+const std::vector<int>& WorkerPool::cpus() const { return _cpus; }
+
+// _____________________________________________________________________________________________________________________
+const std::vector<WorkerTiming>& WorkerPool::timings() const { return _timings; }
+
+// _____________________________________________________________________________________________________________________
+void WorkerPool::_work(size_t id) {
+  if (!_cpus.empty()) {
+    pin_current_thread(_cpus[id % _cpus.size()]);
+  }
+  uint64_t seen = 0;
+  while (true) {
+    const std::function<void(size_t)>* job;
+    {
+      std::unique_lock lock(_mutex);
+      _cv.wait(lock, [&] { return _shutdown || _generation != seen; });
+      if (_shutdown) {
+        return;
+      }
+      seen = _generation;
+      job = _job;
+    }
+    _ready.fetch_add(1, std::memory_order_release);
+    spin_until([&] { return _released.load(std::memory_order_acquire) == seen; });
+    _start_times[id] = clock::now();
+    try {
+      (*job)(id);
+    } catch (...) {
+      _exceptions[id] = std::current_exception();
+    }
+    _finish_times[id] = clock::now();
+    _done.fetch_add(1, std::memory_order_release);
+  }
+}
+
+}  // namespace taskbench::utils
\ No newline at end of file
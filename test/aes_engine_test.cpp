@@ -0,0 +1,130 @@
+/**
+ * Copyright 2023, Leon Freist (https://github.com/lfreist)
+ * Author: Leon Freist <freist.leon@gmail.com>
+ *
+ * This file is part of taskbench.
+ */
+
+#include <taskbench/tasks/cpu/aes_engine.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace taskbench::cpu;
+
+using Bytes = std::vector<unsigned char>;
+
+static int failures = 0;
+
+// _____________________________________________________________________________________________________________________
+static Bytes from_hex(const std::string& hex) {
+  Bytes bytes;
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    bytes.push_back(static_cast<unsigned char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+  }
+  return bytes;
+}
+
+// _____________________________________________________________________________________________________________________
+static void check(bool condition, aes::Implementation implementation, const std::string& what) {
+  if (!condition) {
+    std::printf("FAILED: %s (%s)\n", what.c_str(), aes::to_string(implementation).c_str());
+    ++failures;
+  }
+}
+
+/**
+ * @brief AES-256 GCM known answer test: encrypt, check ciphertext and tag, decrypt and reject a modified ciphertext
+ */
+static void known_answer(aes::Implementation implementation, const std::string& name, const std::string& key,
+                         const std::string& nonce, const std::string& aad, const std::string& plaintext,
+                         const std::string& ciphertext, const std::string& tag) {
+  aes::Engine engine(from_hex(key).data(), implementation);
+  Bytes n = from_hex(nonce);
+  Bytes a = from_hex(aad);
+  Bytes p = from_hex(plaintext);
+  Bytes expected_c = from_hex(ciphertext);
+  Bytes expected_t = from_hex(tag);
+
+  Bytes c(p.size());
+  Bytes t(aes::tag_size);
+  engine.gcm_encrypt(n.data(), a.data(), a.size(), p.data(), c.data(), p.size(), t.data());
+  check(c == expected_c, implementation, name + " ciphertext");
+  check(t == expected_t, implementation, name + " tag");
+
+  Bytes d(c.size());
+  check(engine.gcm_decrypt(n.data(), a.data(), a.size(), c.data(), d.data(), c.size(), t.data()), implementation,
+        name + " authentication");
+  check(d == p, implementation, name + " decryption");
+
+  t[0] ^= 1;
+  check(!engine.gcm_decrypt(n.data(), a.data(), a.size(), c.data(), d.data(), c.size(), t.data()), implementation,
+        name + " modified tag");
+}
+
+/**
+ * @brief Every implementation produces the output of the portable one for sizes around the block and batch sizes and
+ *  counters that wrap around
+ */
+static void agreement(aes::Implementation implementation) {
+  std::mt19937 rng(1);
+  for (size_t size : {0, 1, 15, 16, 17, 127, 128, 129, 255, 256, 257, 1000, 4096, 4099, 100000}) {
+    Bytes key(aes::key_size);
+    Bytes nonce(aes::nonce_size);
+    Bytes aad(size % 50);
+    Bytes input(size);
+    for (auto* bytes : {&key, &nonce, &aad, &input}) {
+      for (auto& byte : *bytes) {
+        byte = static_cast<unsigned char>(rng());
+      }
+    }
+    uint32_t counter = 0xfffffff0 + static_cast<uint32_t>(size % 3);
+    std::string name = "agreement (" + std::to_string(size) + " bytes)";
+
+    aes::Engine reference(key.data(), aes::Implementation::PORTABLE);
+    aes::Engine engine(key.data(), implementation);
+
+    Bytes expected(size);
+    Bytes output(size);
+    reference.ctr(nonce.data(), counter, input.data(), expected.data(), size);
+    engine.ctr(nonce.data(), counter, input.data(), output.data(), size);
+    check(output == expected, implementation, "CTR " + name);
+
+    Bytes expected_tag(aes::tag_size);
+    Bytes tag(aes::tag_size);
+    reference.gcm_encrypt(nonce.data(), aad.data(), aad.size(), input.data(), expected.data(), size,
+                          expected_tag.data());
+    engine.gcm_encrypt(nonce.data(), aad.data(), aad.size(), input.data(), output.data(), size, tag.data());
+    check(output == expected && tag == expected_tag, implementation, "GCM " + name);
+  }
+}
+
+// _____________________________________________________________________________________________________________________
+int main() {
+  for (auto implementation : {aes::Implementation::PORTABLE, aes::Implementation::AESNI, aes::Implementation::VAES}) {
+    if (!aes::is_supported(implementation)) {
+      std::printf("skipped: %s is not supported by this cpu\n", aes::to_string(implementation).c_str());
+      continue;
+    }
+    int previous_failures = failures;
+    // NIST GCM test vectors (McGrew, Viega: The Galois/Counter Mode of Operation), test cases 13, 14 and 16
+    known_answer(implementation, "test case 13", std::string(64, '0'), std::string(24, '0'), "", "", "",
+                 "530f8afbc74536b9a963b4f1c4cb738b");
+    known_answer(implementation, "test case 14", std::string(64, '0'), std::string(24, '0'), "",
+                 std::string(32, '0'), "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919");
+    known_answer(implementation, "test case 16", "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+                 "cafebabefacedbaddecaf888", "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+                 "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf"
+                 "5aa0de657ba637b39",
+                 "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e"
+                 "6393ba7a0abcc9f662",
+                 "76fc6ece0f4e1768cddf8853bb2d551b");
+    agreement(implementation);
+    std::printf("%s: %s\n", failures == previous_failures ? "passed" : "failed",
+                aes::to_string(implementation).c_str());
+  }
+  return failures == 0 ? 0 : 1;
+}
\ No newline at end of file